@@ -0,0 +1,200 @@
+// GridPathfinder benchmark
+//
+// Times road queries on 100x100, 500x500 and 1000x1000 grids against a
+// reference A* in the style GridPathfinder replaced (per-search hash maps,
+// binary heap, a type-name copy per neighbour), and checks that both find
+// paths of equal cost.
+//
+// Usage: GridPathfinderBench [seed]
+
+#include "Simulation/GridPathfinder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using Simulation::GridPathfinder;
+
+namespace {
+
+using Cell = std::pair<u16, u16>;
+
+struct Terrain {
+    const char* name;
+    u16 cost;
+};
+
+// Road step costs used by world generation
+constexpr Terrain TERRAINS[] = {
+    {"Plains", 1},
+    {"Forest", 10},
+    {"Mountain", 10},
+    {"Water", 1000},
+    {"Desert", 5},
+};
+
+u32 GetTerrainCost(const std::string& type) {
+    for (const Terrain& terrain : TERRAINS) {
+        if (type == terrain.name) {
+            return terrain.cost;
+        }
+    }
+    return 5;
+}
+
+u32 GetDistance(Cell a, Cell b) {
+    return static_cast<u32>(std::abs(a.first - b.first) + std::abs(a.second - b.second));
+}
+
+// A* with node maps keyed by cell, as world generation ran it before
+// GridPathfinder
+class ReferencePathfinder {
+public:
+    ReferencePathfinder(u16 width, u16 height, const std::vector<std::string>& types)
+        : width_(width), height_(height), types_(types) {}
+
+    std::vector<Cell> FindPath(Cell start, Cell end) const {
+        struct Node {
+            Cell cell;
+            u32 g_cost;
+            u32 h_cost;
+            Cell parent;
+            u32 GetF() const { return g_cost + h_cost; }
+            bool operator<(const Node& other) const { return GetF() > other.GetF(); }
+        };
+
+        constexpr Cell NO_PARENT{0xFFFF, 0xFFFF};
+        std::priority_queue<Node> open;
+        std::unordered_map<u32, Node> nodes;
+        std::unordered_set<u32> closed;
+
+        Node first{start, 0, GetDistance(start, end), NO_PARENT};
+        nodes[GetKey(start)] = first;
+        open.push(first);
+
+        constexpr int DX[] = {0, 1, 0, -1};
+        constexpr int DY[] = {-1, 0, 1, 0};
+        while (!open.empty()) {
+            Node current = open.top();
+            open.pop();
+            u32 key = GetKey(current.cell);
+            if (!closed.insert(key).second) {
+                continue;
+            }
+
+            if (current.cell == end) {
+                std::vector<Cell> path;
+                for (const Node* node = &nodes[key]; node->parent != NO_PARENT; node = &nodes[GetKey(node->parent)]) {
+                    path.push_back(node->cell);
+                }
+                std::reverse(path.begin(), path.end());
+                return path;
+            }
+
+            for (int i = 0; i < 4; ++i) {
+                int x = current.cell.first + DX[i];
+                int y = current.cell.second + DY[i];
+                if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+                    continue;
+                }
+                Cell cell{static_cast<u16>(x), static_cast<u16>(y)};
+                u32 neighbor_key = GetKey(cell);
+                if (closed.count(neighbor_key)) {
+                    continue;
+                }
+
+                std::string type = types_[neighbor_key];
+                u32 g_cost = current.g_cost + GetTerrainCost(type);
+                auto it = nodes.find(neighbor_key);
+                if (it == nodes.end()) {
+                    Node node{cell, g_cost, GetDistance(cell, end), current.cell};
+                    nodes[neighbor_key] = node;
+                    open.push(node);
+                } else if (g_cost < it->second.g_cost) {
+                    it->second.g_cost = g_cost;
+                    it->second.parent = current.cell;
+                    open.push(it->second);
+                }
+            }
+        }
+        return {};
+    }
+
+private:
+    u16 width_;
+    u16 height_;
+    const std::vector<std::string>& types_;
+
+    u32 GetKey(Cell cell) const { return static_cast<u32>(cell.second) * width_ + cell.first; }
+};
+
+u64 GetPathCost(const GridPathfinder& pathfinder, const std::vector<Cell>& path) {
+    u64 cost = 0;
+    for (const Cell& cell : path) {
+        cost += pathfinder.GetCost(cell.first, cell.second);
+    }
+    return cost;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    u32 seed = argc > 1 ? static_cast<u32>(std::strtoul(argv[1], nullptr, 10)) : 0;
+
+    std::printf("%-10s %8s %14s %14s %8s %10s\n", "grid", "queries", "reference ms", "pathfinder ms", "speedup", "mismatches");
+    for (u16 size : {100, 500, 1000}) {
+        std::mt19937 rng(seed + size);
+
+        // Banded terrain, mostly open with forest, mountain, water and desert strips
+        std::vector<std::string> types(static_cast<size_t>(size) * size);
+        GridPathfinder pathfinder;
+        pathfinder.Resize(size, size);
+        for (u8 terrain = 0; terrain < std::size(TERRAINS); ++terrain) {
+            pathfinder.SetClassCost(terrain, TERRAINS[terrain].cost);
+        }
+        for (u16 y = 0; y < size; ++y) {
+            for (u16 x = 0; x < size; ++x) {
+                u32 band = (x / 7 + y / 5 * 3 + rng() % 3) % 11;
+                u8 terrain = band < 6 ? 0 : band < 8 ? 1 : band < 9 ? 2 : band < 10 ? 3 : 4;
+                types[static_cast<size_t>(y) * size + x] = TERRAINS[terrain].name;
+                pathfinder.SetClass(x, y, terrain);
+            }
+        }
+        ReferencePathfinder reference(size, size, types);
+
+        u32 queries = size >= 1000 ? 10 : 30;
+        double reference_ms = 0.0;
+        double pathfinder_ms = 0.0;
+        u32 mismatches = 0;
+        std::vector<Cell> path;
+        for (u32 query = 0; query < queries; ++query) {
+            Cell start{static_cast<u16>(rng() % size), static_cast<u16>(rng() % size)};
+            Cell end{static_cast<u16>(rng() % size), static_cast<u16>(rng() % size)};
+
+            auto t0 = std::chrono::steady_clock::now();
+            std::vector<Cell> reference_path = reference.FindPath(start, end);
+            auto t1 = std::chrono::steady_clock::now();
+            bool found = pathfinder.FindPath(start, end, path);
+            auto t2 = std::chrono::steady_clock::now();
+
+            reference_ms += std::chrono::duration<double, std::milli>(t1 - t0).count();
+            pathfinder_ms += std::chrono::duration<double, std::milli>(t2 - t1).count();
+            bool reference_found = start == end || !reference_path.empty();
+            if (found != reference_found || GetPathCost(pathfinder, path) != GetPathCost(pathfinder, reference_path)) {
+                ++mismatches;
+            }
+        }
+
+        std::printf("%4ux%-5u %8u %14.2f %14.2f %7.1fx %10u\n", size, size, queries,
+                    reference_ms / queries, pathfinder_ms / queries, reference_ms / pathfinder_ms, mismatches);
+    }
+    return 0;
+}
@@ -1,20 +1,30 @@
 #pragma once
 
 #include "Core/Types.h"
-#include <vector>
+#include "Core/Config.h"
 
 namespace Components {
 
+// Hero tiers (by renown thresholds in HeroesConfig::RenownConfig)
+enum class HeroTier : u8 {
+    Local = 0,
+    Regional = 1,
+    National = 2,
+    Legendary = 3
+};
+constexpr u8 HERO_TIER_COUNT = 4;
+
+// Tier of a renown value (Legendary from legendary_hero_threshold up)
+HeroTier GetTierForRenown(u16 renown, const Config::HeroesConfig::RenownConfig& config);
+
 // Hero component - only for entities with renown > 0
+// (Heroes::HeroSystem stores heroes in a HeroTable; this is a row snapshot)
 struct Hero {
     EntityID entity_id = INVALID_ENTITY_ID;
     u16 renown = 0;
     u8 influence_radius = 0;
     u8 hero_type = 0;  // 0=Combat, 1=Crafting, 2=Knowledge, 3=Social, 4=Mixed
-    
-    // Influenced regions (sparse, updated periodically)
-    std::vector<RegionID> influenced_regions;
-    std::vector<f32> influence_strengths;
+    RegionID region_id = INVALID_REGION_ID;  // Region the hero currently resides in
     
     // Timestamps
     Tick last_accomplishment_tick = 0;
@@ -25,6 +35,7 @@ struct Hero {
     bool IsRegionalHero() const;
     bool IsNationalHero() const;
     bool IsLegendaryHero() const;
+    HeroTier GetTier() const;
     
     // Get hero tier name
     const char* GetTierName() const;
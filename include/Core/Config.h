@@ -19,8 +19,15 @@ struct WorldConfig {
     f32 world_height = 10000.0f;
     f32 time_scale = 1.0f;
     f32 tick_rate = 60.0f;
+    u32 ticks_per_year = 365;  // Simulation ticks per in-game year
     u16 region_grid_width = 100;   // Grid width for region layout
     u16 region_grid_height = 100;  // Grid height for region layout
+    u64 world_seed = 0;  // World generation seed (0 = seed kept in the world cache, drawn once)
+    bool world_cache_enabled = true;  // Reuse generated worlds (and keep the drawn seed)
+    std::string world_cache_directory = "cache/worlds";  // Generated-world cache files
+    bool world_cache_passes = true;  // Also cache the state after each pass, so edits re-run only later passes
+    u32 world_cache_max_size_mb = 2048;  // Cache size limit; least recently used files go first (0 = no limit)
+    u32 extra_settlements = 0;  // Villages placed after the required settlements
 };
 
 // Performance configuration
@@ -118,7 +125,7 @@ struct HeroesConfig {
         u16 local_hero_threshold = 100;
         u16 regional_hero_threshold = 1000;
         u16 national_hero_threshold = 10000;
-        u16 legendary_hero_threshold = 10001;
+        u16 legendary_hero_threshold = 10001;  // Above national_hero_threshold
         bool decay_enabled = false;
         f32 decay_rate_per_year = 1.0f;
         f32 decay_inactivity_years = 5.0f;
@@ -222,8 +229,8 @@ struct RegionsConfig {
     std::vector<std::string> types;
     u32 default_capacity = 10000;
     f32 capacity_variance = 0.5f;
-    std::vector<std::string> resource_types;
-    u8 trait_categories = 5;
+    std::vector<std::string> resource_types;  // At most MAX_RESOURCES entries
+    u8 trait_categories = 5;  // At most MAX_TRAIT_CATEGORIES
     u8 neighbor_connections_min = 2;
     u8 neighbor_connections_max = 6;
     bool race_attraction_enabled = true;
@@ -231,6 +238,11 @@ struct RegionsConfig {
     // Region definitions (loaded from JSON)
     std::unordered_map<std::string, Simulation::RegionDefinition> region_definitions;
     std::string region_data_path = "assets/data/regions.json";
+    
+    // Resource name -> slot index (rebuilt whenever resource_types changes)
+    std::unordered_map<std::string, ResourceIndex> resource_indices;
+    void IndexResourceTypes();
+    ResourceIndex GetResourceIndex(const std::string& resource_type) const;
 };
 
 // Events configuration
@@ -241,7 +253,10 @@ struct EventsConfig {
     f32 regional_event_frequency = 0.01f;
     f32 individual_event_frequency = 0.1f;
     u32 event_history_size = 10000;
+    u32 event_archive_size = 1000000;  // Compacted records kept past event_history_size
     f32 cascade_probability = 0.1f;
+    u32 max_cascade_depth = 8;               // Follow-up generations kept per root event
+    u32 max_cascade_events_per_tick = 1024;  // Further follow-ups spill into the next tick
 };
 
 // Memory configuration
@@ -30,6 +30,14 @@ constexpr RaceID INVALID_RACE_ID = 255;
 // Skill ID type
 using SkillID = u16;
 
+// Resource slot index (resolved from regions.resource_types at config load)
+using ResourceIndex = u8;
+constexpr ResourceIndex INVALID_RESOURCE_INDEX = 255;
+constexpr u8 MAX_RESOURCES = 8;
+
+// Trait categories per region (each category is a 64-bit bitfield)
+constexpr u8 MAX_TRAIT_CATEGORIES = 8;
+
 // Tick type for simulation time
 using Tick = u64;
 
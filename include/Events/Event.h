@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "Utils/InlineVector.h"
+#include <array>
+#include <bit>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Events {
+
+using EventID = u64;
+constexpr EventID INVALID_EVENT_ID = 0;
+
+// Interned event type (dense index into the registered event types)
+using EventTypeID = u16;
+constexpr EventTypeID INVALID_EVENT_TYPE = 0xFFFF;
+
+// Inline capacities of an event record
+constexpr u8 MAX_EVENT_FIELDS = 6;
+constexpr u8 MAX_EVENT_ENTITIES = 4;
+constexpr u8 MAX_EVENT_REGIONS = 8;
+constexpr u8 MAX_TRIGGERED_EVENTS = 4;
+constexpr u8 INVALID_EVENT_FIELD = 255;
+
+// Event types
+enum class EventType : u8 {
+    Global = 0,
+    Regional = 1,
+    Individual = 2
+};
+
+// Event priority
+enum class EventPriority : u8 {
+    Low = 0,
+    Normal = 1,
+    High = 2,
+    Critical = 3
+};
+
+// Payload field types
+enum class EventFieldType : u8 {
+    Float = 0,
+    Int = 1,
+    Entity = 2,
+    Region = 3
+};
+
+// Payload field declaration (field i of a type lives in payload slot i)
+struct EventField {
+    std::string name;
+    EventFieldType type = EventFieldType::Int;
+};
+
+// Registered event type
+struct EventTypeInfo {
+    std::string name;
+    std::vector<EventField> fields;
+};
+
+// Event record
+//
+// Fixed-size and trivially copyable so events live in a preallocated pool.
+// Payload slots hold the fields declared by the event's type.
+struct Event {
+    EventID id = INVALID_EVENT_ID;
+    Tick scheduled_tick = 0;
+    Tick execution_tick = 0;
+    EventTypeID type_id = INVALID_EVENT_TYPE;
+    EventType type = EventType::Individual;
+    EventPriority priority = EventPriority::Normal;
+    u8 cascade_depth = 0;  // Follow-up generation (0 = scheduled directly)
+    
+    // Event data (typed by the event type's fields)
+    std::array<u64, MAX_EVENT_FIELDS> payload{};
+    
+    // Affected entities/regions
+    Utils::InlineVector<EntityID, MAX_EVENT_ENTITIES> affected_entities;
+    Utils::InlineVector<RegionID, MAX_EVENT_REGIONS> affected_regions;
+    
+    // Cascading events (the first MAX_TRIGGERED_EVENTS follow-ups)
+    Utils::InlineVector<EventID, MAX_TRIGGERED_EVENTS> triggered_events;
+    
+    f32 GetFloat(u8 slot) const { return std::bit_cast<f32>(static_cast<u32>(payload[slot])); }
+    void SetFloat(u8 slot, f32 value) { payload[slot] = std::bit_cast<u32>(value); }
+    u32 GetInt(u8 slot) const { return static_cast<u32>(payload[slot]); }
+    void SetInt(u8 slot, u32 value) { payload[slot] = value; }
+    EntityID GetEntity(u8 slot) const { return payload[slot]; }
+    void SetEntity(u8 slot, EntityID value) { payload[slot] = value; }
+    RegionID GetRegion(u8 slot) const { return static_cast<RegionID>(payload[slot]); }
+    void SetRegion(u8 slot, RegionID value) { payload[slot] = value; }
+};
+static_assert(std::is_trivially_copyable_v<Event>, "Event records are copied in and out of the pool");
+
+} // namespace Events
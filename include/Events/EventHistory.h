@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "Events/Event.h"
+#include "Utils/InlineVector.h"
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace Events {
+
+// Executed event as kept in history (payload and follow-ups are dropped)
+struct EventRecord {
+    EventID id = INVALID_EVENT_ID;
+    Tick tick = 0;  // Execution tick
+    EventTypeID type_id = INVALID_EVENT_TYPE;
+    EventType type = EventType::Individual;
+    EventPriority priority = EventPriority::Normal;
+    Utils::InlineVector<EntityID, MAX_EVENT_ENTITIES> affected_entities;
+    Utils::InlineVector<RegionID, MAX_EVENT_REGIONS> affected_regions;
+};
+
+// Bounded history of executed events
+//
+// Recent records live in a fixed ring of blocks. When the ring is full its
+// oldest block is compacted into a columnar, delta-encoded archive chunk;
+// the archive keeps at most archive_capacity records and drops its oldest
+// chunks beyond that. Blocks and chunks carry a tick range. Ring blocks keep
+// their sorted region and entity IDs; the archive keeps a posting list of
+// chunks per region and entity, so region and entity queries decode only
+// chunks that hold a match. Queries are safe to run concurrently with each
+// other (not with Record).
+class EventHistory {
+public:
+    // Records per ring block and archive chunk
+    static constexpr u32 BLOCK_SIZE = 256;
+
+    // Allocate the ring (capacity rounded up to whole blocks) and drop all records
+    void Initialize(u32 capacity, u32 archive_capacity);
+
+    // Append an executed event
+    void Record(const Event& event);
+
+    // Records in the ring, and in the archive
+    u32 GetRecentCount() const { return recent_count_; }
+    u32 GetArchivedCount() const { return archived_count_; }
+    bool IsEmpty() const { return recent_count_ == 0 && archived_count_ == 0; }
+
+    // Ring record by age (0 = oldest still in the ring)
+    const EventRecord& GetRecent(u32 index) const;
+
+    // Append matching records with tick in [first_tick, last_tick] to out,
+    // oldest first (archive before ring)
+    void QueryTickRange(Tick first_tick, Tick last_tick, std::vector<EventRecord>& out) const;
+    void QueryRegion(RegionID region_id, Tick first_tick, Tick last_tick, std::vector<EventRecord>& out) const;
+    void QueryEntity(EntityID entity_id, Tick first_tick, Tick last_tick, std::vector<EventRecord>& out) const;
+
+    // Approximate heap size of the archive
+    size_t GetArchiveBytes() const;
+
+private:
+    // Tick range of a block or chunk
+    struct Summary {
+        Tick first_tick = 0;
+        Tick last_tick = 0;
+
+        void Add(const EventRecord& record);
+        bool Overlaps(Tick first, Tick last) const { return first_tick <= last && last_tick >= first; }
+    };
+
+    struct Block {
+        std::vector<EventRecord> records;
+        Summary summary;
+        std::vector<RegionID> regions;   // Sorted, unique
+        std::vector<EntityID> entities;  // Sorted, unique
+    };
+
+    // Columns of a compacted block. Varint streams hold zigzag deltas from
+    // the previous value of the same column.
+    struct ArchiveChunk {
+        u32 count = 0;
+        Summary summary;
+        std::vector<u8> ids;
+        std::vector<u8> ticks;
+        std::vector<u16> type_ids;
+        std::vector<u8> kinds;  // EventType | EventPriority << 4
+        std::vector<u8> entity_counts;
+        std::vector<u8> entities;
+        std::vector<u8> region_counts;
+        std::vector<u8> regions;
+    };
+
+    std::vector<Block> blocks_;  // Ring of blocks
+    u32 oldest_block_ = 0;
+    u32 block_count_ = 0;        // Blocks in use (the newest one may be partial)
+    u32 recent_count_ = 0;
+
+    // Archive chunks holding one region or entity, by chunk sequence number
+    // (ascending); entries before head belong to dropped chunks
+    struct Postings {
+        std::vector<u32> chunks;
+        u32 head = 0;
+
+        void Add(u32 sequence);
+        void DropFront();
+    };
+
+    std::deque<ArchiveChunk> archive_;
+    u32 archive_capacity_ = 0;
+    u32 archived_count_ = 0;
+    u32 first_chunk_ = 0;  // Sequence number of archive_.front()
+    std::unordered_map<RegionID, Postings> region_postings_;
+    std::unordered_map<EntityID, Postings> entity_postings_;
+
+    void ArchiveBlock(Block& block);
+    void DropOldestChunk();
+    void DecodeChunk(const ArchiveChunk& chunk, std::vector<EventRecord>& out) const;
+
+    // Collect matches from archive chunks listed in postings[key] and ring
+    // blocks whose block_ids hold key; every chunk and block in the tick
+    // range when postings is null
+    template<typename Key, typename Match>
+    void Query(Tick first_tick, Tick last_tick, const std::unordered_map<Key, Postings>* postings,
+               std::vector<Key> Block::*block_ids, Key key, Match match, std::vector<EventRecord>& out) const;
+};
+
+} // namespace Events
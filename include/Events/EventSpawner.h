@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "Core/Config.h"
+#include <span>
+#include <vector>
+
+namespace Events {
+
+// Random event spawning from the configured per-tick frequencies
+//
+// Instead of one Bernoulli roll per region or entity, each call draws how
+// many are hit (binomial) and then picks that many distinct indices (Floyd's
+// sampling), so the number of draws follows the number of events rather than
+// the population. Draws come from Utils::Random, so results follow its seed.
+class EventSpawner {
+public:
+    // Member of a region picked for an individual event (index into the
+    // caller's member list of that region)
+    struct IndividualSpawn {
+        RegionID region_id;
+        u32 member_index;
+    };
+
+    // Read frequencies from the configuration
+    void Initialize();
+    void Initialize(const Config::EventsConfig& config);
+
+    // Whether a global event starts during elapsed_ticks
+    bool SpawnGlobal(Tick elapsed_ticks = 1);
+
+    // Append the regions hit by a regional event during elapsed_ticks
+    // (each region at most once, in input order)
+    void SpawnRegional(std::span<const RegionID> regions, std::vector<RegionID>& out, Tick elapsed_ticks = 1);
+
+    // Append the members of a region hit by an individual event during
+    // elapsed_ticks (each member at most once, by ascending index)
+    void SpawnIndividual(RegionID region_id, u32 population, std::vector<IndividualSpawn>& out,
+                         Tick elapsed_ticks = 1);
+
+private:
+    f32 global_event_frequency_ = 0.0f;
+    f32 regional_event_frequency_ = 0.0f;
+    f32 individual_event_frequency_ = 0.0f;
+
+    std::vector<u32> picks_;  // Scratch for index sampling
+
+    // Chance of at least one hit in elapsed_ticks per-tick rolls
+    static f32 GetStepProbability(f32 per_tick, Tick elapsed_ticks);
+
+    // Fill picks_ with count distinct indices in [0, population), ascending
+    void SampleIndices(u32 population, u32 count);
+};
+
+} // namespace Events
@@ -2,54 +2,26 @@
 
 #include "Core/Types.h"
 #include "Core/Config.h"
+#include "Events/Event.h"
+#include "Events/EventHistory.h"
+#include "Utils/TimingWheel.h"
 #include <string>
 #include <vector>
-#include <queue>
 #include <functional>
+#include <initializer_list>
+#include <span>
 #include <unordered_map>
 
 namespace Events {
 
-using EventID = u64;
-
-// Event types
-enum class EventType : u8 {
-    Global = 0,
-    Regional = 1,
-    Individual = 2
-};
-
-// Event priority
-enum class EventPriority : u8 {
-    Low = 0,
-    Normal = 1,
-    High = 2,
-    Critical = 3
-};
-
-// Base event structure
-struct Event {
-    EventID id = 0;
-    EventType type = EventType::Individual;
-    EventPriority priority = EventPriority::Normal;
-    Tick scheduled_tick = 0;
-    Tick execution_tick = 0;
-    std::string event_name;
-    
-    // Event data (flexible)
-    std::unordered_map<std::string, std::string> string_data;
-    std::unordered_map<std::string, f32> float_data;
-    std::unordered_map<std::string, u32> int_data;
-    
-    // Affected entities/regions
-    std::vector<EntityID> affected_entities;
-    std::vector<RegionID> affected_regions;
-    
-    // Cascading events
-    std::vector<EventID> triggered_events;
-    
-    Event() = default;
-    virtual ~Event() = default;
+// Cascade activity of one Update
+struct CascadeStats {
+    u32 triggered = 0;      // Follow-ups accepted (run this tick or spilled)
+    u32 executed = 0;       // Follow-ups run this tick
+    u32 spilled = 0;        // Follow-ups deferred to the next tick by the per-tick limit
+    u32 dropped = 0;        // Follow-ups past max_cascade_depth
+    u32 largest_level = 0;  // Most follow-ups run in one breadth-first level
+    u8 deepest = 0;         // Highest cascade_depth run
 };
 
 // Event system
@@ -64,29 +36,67 @@ public:
     // Update event system
     void Update(f32 delta_time, Tick current_tick);
     
-    // Schedule an event
-    EventID ScheduleEvent(std::unique_ptr<Event> event, Tick delay_ticks = 0);
+    // Register an event type and its payload fields (returns the existing ID
+    // for a known name, INVALID_EVENT_TYPE if there are too many fields)
+    EventTypeID RegisterEventType(const std::string& name, std::initializer_list<EventField> fields = {});
+    
+    // Look up event types
+    EventTypeID GetEventTypeID(const std::string& name) const;
+    const EventTypeInfo* GetEventTypeInfo(EventTypeID type_id) const;
+    
+    // Payload slot of a field (INVALID_EVENT_FIELD if the type has none)
+    u8 GetFieldSlot(EventTypeID type_id, const std::string& field_name) const;
+    
+    // Schedule an event (copied into the pool; INVALID_EVENT_ID if the queue is full)
+    EventID ScheduleEvent(const Event& event, Tick delay_ticks = 0);
     
     // Schedule immediate event
-    EventID ScheduleImmediateEvent(std::unique_ptr<Event> event);
+    EventID ScheduleImmediateEvent(const Event& event);
     
     // Cancel an event
     bool CancelEvent(EventID event_id);
     
-    // Get event
+    // Get scheduled event (valid until it executes or is cancelled)
     Event* GetEvent(EventID event_id);
     const Event* GetEvent(EventID event_id) const;
     
-    // Register event handler
-    void RegisterHandler(const std::string& event_name, std::function<void(Event&)> handler);
-    
-    // Create event templates
-    std::unique_ptr<Event> CreateGlobalEvent(const std::string& name);
-    std::unique_ptr<Event> CreateRegionalEvent(const std::string& name, RegionID region_id);
-    std::unique_ptr<Event> CreateIndividualEvent(const std::string& name, EntityID entity_id);
-    
-    // Get event history
-    const std::vector<std::unique_ptr<Event>>& GetEventHistory() const;
+    // Register event handler (one per type; names are registered on first use)
+    //
+    // Region-local handlers only touch state of their event's affected
+    // regions and never schedule or cancel events. Due events of such types
+    // that share no region run in parallel; events sharing a region (directly
+    // or through a multi-region event) run in order on one thread.
+    void RegisterHandler(const std::string& event_name, std::function<void(Event&)> handler, bool region_local = false);
+    void RegisterHandler(EventTypeID type_id, std::function<void(Event&)> handler, bool region_local = false);
+    
+    // Register batch handler, called once per tick with all due events of the
+    // type (takes precedence over a per-event handler)
+    void RegisterBatchHandler(const std::string& event_name, std::function<void(std::span<Event>)> handler);
+    void RegisterBatchHandler(EventTypeID type_id, std::function<void(std::span<Event>)> handler);
+    
+    // Let events of one type trigger another: after a cause event runs, each
+    // registered effect follows with cascade_probability, on the cause's
+    // entities and regions
+    void RegisterCascade(EventTypeID cause_type, EventTypeID effect_type);
+    
+    // Trigger a follow-up of an executing event (from its handler). Follow-ups
+    // run breadth-first after the tick's due events, up to max_cascade_depth
+    // generations and max_cascade_events_per_tick per tick; later ones are
+    // scheduled for the next tick. Returns INVALID_EVENT_ID if dropped.
+    EventID TriggerEvent(Event& cause, const Event& effect);
+    
+    // Cascade activity of the last Update
+    const CascadeStats& GetCascadeStats() const { return cascade_stats_; }
+    
+    // Create event templates (names are registered on first use)
+    Event CreateGlobalEvent(const std::string& name);
+    Event CreateRegionalEvent(const std::string& name, RegionID region_id);
+    Event CreateIndividualEvent(const std::string& name, EntityID entity_id);
+    Event CreateEvent(EventTypeID type_id, EventType type);
+    
+    // Get event history (bounded to event_history_size recent records plus
+    // event_archive_size compacted ones)
+    const EventHistory& GetEventHistory() const;
     
     // Get active event count
     u32 GetActiveEventCount() const;
@@ -94,35 +104,65 @@ public:
 private:
     Config::EventsConfig config_;
     
-    // Event storage
-    std::priority_queue<std::unique_ptr<Event>, std::vector<std::unique_ptr<Event>>, EventComparator> event_queue_;
-    std::unordered_map<EventID, Event*> active_events_;
-    std::vector<std::unique_ptr<Event>> event_history_;
-    
-    // Event handlers
-    std::unordered_map<std::string, std::function<void(Event&)>> event_handlers_;
+    // Registered event types
+    std::vector<EventTypeInfo> event_types_;
+    std::unordered_map<std::string, EventTypeID> event_type_ids_;
+    
+    // Event storage: scheduled events live in a pool of event_queue_size
+    // records and are keyed in the wheel by execution_tick (cancelled events
+    // leave stale entries). IDs are (sequence << 32) | (slot + 1).
+    std::vector<Event> event_pool_;
+    std::vector<u32> free_slots_;
+    u32 next_sequence_ = 1;
+    Utils::TimingWheel<EventID> event_wheel_;
+    std::vector<Utils::TimingWheel<EventID>::Entry> due_events_;
+    
+    // Due events of one Update, in execution order
+    struct ReadyEvent {
+        Tick execution_tick;
+        EventPriority priority;
+        EventTypeID type_id;
+        EventID id;
+    };
+    std::vector<ReadyEvent> ready_events_;
+    EventHistory event_history_;
+    
+    // Event handlers (indexed by EventTypeID)
+    std::vector<std::function<void(Event&)>> handlers_;
+    std::vector<std::function<void(std::span<Event>)>> batch_handlers_;
+    std::vector<std::vector<Event>> batches_;  // Batched events of the tick being processed
+    std::vector<bool> region_local_;           // Handler only touches affected regions
+    std::vector<std::vector<EventTypeID>> cascades_;  // Effect types by cause type
+    
+    // Follow-ups waiting for the current breadth-first level to finish
+    // (IDs carry slot 0, so they are never found in the pool)
+    std::vector<Event> cascade_queue_;
+    std::vector<Event> cascade_level_;
+    u32 cascade_budget_ = 0;  // Follow-ups that may still run this tick
+    CascadeStats cascade_stats_;
+    
+    // Run of region-local events being executed, split into region groups
+    // (events of a group are contiguous in group_events_, in execution order)
+    std::vector<Event> regional_events_;
+    std::vector<u32> group_parents_;  // Union-find over regional_events_
+    std::vector<u32> group_ids_;
+    std::unordered_map<RegionID, u32> region_events_;  // Region -> first event touching it
+    std::vector<u32> group_events_;
+    std::vector<u32> group_offsets_;
     
-    EventID next_event_id_ = 1;
     Tick current_tick_ = 0;
     
+    static constexpr u32 INVALID_EVENT_SLOT = 0xFFFFFFFF;
+    u32 FindSlot(EventID event_id) const;  // Pool slot of a scheduled event
     void ProcessEventQueue(Tick current_tick);
+    void ProcessDueTick(size_t begin, size_t end);
+    bool HasBatchHandler(EventTypeID type_id) const;
+    bool IsRegionLocal(const ReadyEvent& ready) const;
+    void ProcessRegionalRun(size_t begin, size_t end);
+    u32 FindGroup(u32 event_index);
     void ExecuteEvent(Event& event);
     void HandleCascadingEvents(Event& event);
-    
-    // Event comparator for priority queue
-    struct EventComparator {
-        bool operator()(const std::unique_ptr<Event>& a, const std::unique_ptr<Event>& b) const {
-            if (a->priority != b->priority) {
-                return a->priority < b->priority;
-            }
-            return a->scheduled_tick > b->scheduled_tick;
-        }
-    };
+    void ProcessCascades();
 };
 
 } // namespace Events
-
-
-
-
-
@@ -6,8 +6,18 @@
 #include "Components/Renown.h"
 #include "Components/Inhabitant.h"
 #include "Components/Skills.h"
+#include "Heroes/InfluenceField.h"
+#include "Heroes/HeroTable.h"
+#include "Utils/TimingWheel.h"
+#include <array>
+#include <span>
+#include <string>
 #include <vector>
-#include <unordered_map>
+
+namespace Simulation {
+class World;
+class LODSystem;
+}
 
 namespace Heroes {
 
@@ -20,6 +30,13 @@ public:
     // Initialize hero system
     void Initialize();
     
+    // Set the world whose region grid receives hero influence
+    void SetWorld(const Simulation::World* world);
+    
+    // Set the LOD system; renown decay of heroes in formula-LOD regions is
+    // applied lazily
+    void SetLODSystem(const Simulation::LODSystem* lod_system) { lod_system_ = lod_system; }
+    
     // Update hero system
     void Update(f32 delta_time, Tick current_tick);
     
@@ -29,15 +46,24 @@ public:
     // Award renown to entity
     void AwardRenown(EntityID entity, u16 amount, const std::string& source);
     
-    // Get hero data
-    Components::Hero* GetHero(EntityID entity);
-    const Components::Hero* GetHero(EntityID entity) const;
+    // Move hero to another region
+    void SetHeroRegion(EntityID entity, RegionID region_id);
+    
+    // Remove hero (death); its influence is withdrawn on the next update
+    void RemoveHero(EntityID entity);
+    
+    // Get hero data (false if entity is not a hero)
+    bool GetHero(EntityID entity, Components::Hero& out_hero) const;
     
     // Check if entity is hero
     bool IsHero(EntityID entity) const;
     
-    // Get all hero IDs
-    std::vector<EntityID> GetAllHeroes() const;
+    // Get all hero IDs, or those of one tier (valid until heroes change)
+    std::span<const EntityID> GetAllHeroes() const { return heroes_.GetEntities(); }
+    std::span<const EntityID> GetHeroesOfTier(Components::HeroTier tier) const { return heroes_.GetEntities(tier); }
+    
+    // Get hero registry
+    const HeroTable& GetHeroTable() const { return heroes_; }
     
     // Calculate renown from skills
     u16 CalculateRenownFromSkills(const Components::Skills& skills) const;
@@ -54,9 +80,16 @@ public:
     // Award renown for accomplishment
     void AwardAccomplishmentRenown(EntityID entity, const std::string& accomplishment_type);
     
-    // Update hero influences on regions
+    // Apply pending influence changes of dirty heroes to the shared field
     void UpdateHeroInfluences();
     
+    // Rebuild the shared influence field from every hero
+    void RebuildHeroInfluences();
+    
+    // Get total hero influence on a region
+    f32 GetRegionInfluence(RegionID region_id) const;
+    const InfluenceField& GetInfluenceField() const { return influence_field_; }
+    
     // Get hero tier
     const char* GetHeroTier(u16 renown) const;
     
@@ -68,11 +101,41 @@ public:
     
 private:
     Config::HeroesConfig config_;
-    std::unordered_map<EntityID, Components::Hero> heroes_;
-    
+    HeroTable heroes_;
+    
+    const Simulation::World* world_ = nullptr;
+    const Simulation::LODSystem* lod_system_ = nullptr;
+    Tick current_tick_ = 0;
+    Tick last_influence_update_tick_ = 0;
+    
+    // Shared influence field, updated one tier at a time
+    InfluenceField influence_field_;
+    std::array<std::vector<InfluenceSource>, Components::HERO_TIER_COUNT> tier_sources_;
+    
+    // Heroes whose applied contribution is stale, and contributions of
+    // removed heroes still to be withdrawn (keyed by tier)
+    std::vector<EntityID> dirty_heroes_;
+    std::array<std::vector<InfluenceSource>, Components::HERO_TIER_COUNT> removed_sources_;
+    
+    // Incremental f32 updates drift; resync with a full rebuild periodically
+    u32 incremental_updates_since_rebuild_ = 0;
+    static constexpr u32 INFLUENCE_REBUILD_INTERVAL = 64;
+    
+    // Renown decay: each hero has one timer, due when its decayed renown next
+    // drops; the amount owed is closed-form in elapsed ticks
+    Utils::TimingWheel<EntityID> decay_wheel_;
+    std::vector<Utils::TimingWheel<EntityID>::Entry> decay_due_;
+    Tick decay_delay_ticks_ = 0;      // Inactivity before decay starts
+    f64 decay_ticks_per_point_ = 0.0; // Ticks per renown lost (0 = no decay)
+    
+    u16 GetDecayOwed(u32 row, Tick tick) const;
+    u32 CatchUpDecay(u32 row);  // Returns the hero's new row (invalid if no longer a hero)
+    void ScheduleDecay(u32 row);
+    u32 SetRenown(u32 row, u16 renown);  // Returns the hero's new row
+    void MarkInfluenceDirty(u32 row);
     void UpdateRenownDecay(Tick current_tick);
-    void UpdateInfluenceForHero(EntityID hero_id);
     u8 DetermineHeroType(const Components::Skills& skills) const;
+    u8 GetTierRadius(Components::HeroTier tier) const;
 };
 
 } // namespace Heroes
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "Components/Hero.h"
+#include <array>
+#include <span>
+#include <vector>
+
+namespace Heroes {
+
+constexpr u32 INVALID_HERO_ROW = 0xFFFFFFFF;
+
+// Dense hero registry
+//
+// Hero fields are stored column-wise and rows are kept partitioned by tier,
+// so each tier is a contiguous row range and a pass over one field reads one
+// column. Rows move when a hero changes tier or another hero is removed, so
+// callers look rows up with Find() instead of holding on to them.
+class HeroTable {
+public:
+    HeroTable();
+    ~HeroTable();
+
+    // Remove all heroes
+    void Clear();
+
+    u32 GetCount() const { return static_cast<u32>(entities_.size()); }
+    bool IsEmpty() const { return entities_.empty(); }
+
+    // Row of an entity (INVALID_HERO_ROW if not a hero)
+    u32 Find(EntityID entity) const;
+
+    // Add a hero with zeroed fields to a tier, returns its row
+    u32 Insert(EntityID entity, Components::HeroTier tier);
+
+    // Remove the hero in a row
+    void Remove(u32 row);
+
+    // Move a hero to another tier, returns its new row
+    u32 SetTier(u32 row, Components::HeroTier tier);
+
+    // Row range [begin, end) of a tier
+    u32 GetTierBegin(Components::HeroTier tier) const { return tier_begin_[static_cast<u8>(tier)]; }
+    u32 GetTierEnd(Components::HeroTier tier) const { return tier_begin_[static_cast<u8>(tier) + 1]; }
+
+    // Entity column, for all heroes or one tier
+    std::span<const EntityID> GetEntities() const { return entities_; }
+    std::span<const EntityID> GetEntities(Components::HeroTier tier) const;
+
+    // Fields
+    EntityID GetEntity(u32 row) const { return entities_[row]; }
+    Components::HeroTier GetTier(u32 row) const { return tiers_[row]; }
+
+    u16 GetRenown(u32 row) const { return renown_[row]; }
+    void SetRenown(u32 row, u16 renown) { renown_[row] = renown; }
+
+    u8 GetHeroType(u32 row) const { return hero_types_[row]; }
+    void SetHeroType(u32 row, u8 hero_type) { hero_types_[row] = hero_type; }
+
+    RegionID GetRegion(u32 row) const { return regions_[row]; }
+    void SetRegion(u32 row, RegionID region_id) { regions_[row] = region_id; }
+
+    Tick GetLastAccomplishmentTick(u32 row) const { return last_accomplishment_ticks_[row]; }
+    void SetLastAccomplishmentTick(u32 row, Tick tick) { last_accomplishment_ticks_[row] = tick; }
+
+    Tick GetPromotionTick(u32 row) const { return promotion_ticks_[row]; }
+    void SetPromotionTick(u32 row, Tick tick) { promotion_ticks_[row] = tick; }
+
+    // Contribution currently applied to the shared influence field
+    RegionID GetAppliedRegion(u32 row) const { return applied_regions_[row]; }
+    u16 GetAppliedRenown(u32 row) const { return applied_renown_[row]; }
+    void SetApplied(u32 row, RegionID region_id, u16 renown);
+
+    // Renown already removed by decay since the last accomplishment, and the
+    // tick of the hero's pending decay timer
+    u16 GetDecayApplied(u32 row) const { return decay_applied_[row]; }
+    void SetDecayApplied(u32 row, u16 amount) { decay_applied_[row] = amount; }
+    Tick GetDecayDueTick(u32 row) const { return decay_due_ticks_[row]; }
+    void SetDecayDueTick(u32 row, Tick tick) { decay_due_ticks_[row] = tick; }
+
+    bool IsInfluenceDirty(u32 row) const { return influence_dirty_[row] != 0; }
+    void SetInfluenceDirty(u32 row, bool dirty) { influence_dirty_[row] = dirty ? 1 : 0; }
+
+private:
+    // Columns (indexed by row)
+    std::vector<EntityID> entities_;
+    std::vector<Components::HeroTier> tiers_;
+    std::vector<u16> renown_;
+    std::vector<u8> hero_types_;
+    std::vector<RegionID> regions_;
+    std::vector<Tick> last_accomplishment_ticks_;
+    std::vector<Tick> promotion_ticks_;
+    std::vector<RegionID> applied_regions_;
+    std::vector<u16> applied_renown_;
+    std::vector<u8> influence_dirty_;
+    std::vector<u16> decay_applied_;
+    std::vector<Tick> decay_due_ticks_;
+
+    // First row of each tier; tier_begin_[HERO_TIER_COUNT] is the row count
+    std::array<u32, Components::HERO_TIER_COUNT + 1> tier_begin_{};
+
+    // Entity lookup: IDs kept sorted, with their rows alongside
+    std::vector<EntityID> sorted_entities_;
+    std::vector<u32> sorted_rows_;
+
+    u32& LookupRow(EntityID entity);
+    void SwapRows(u32 a, u32 b);
+};
+
+} // namespace Heroes
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <span>
+#include <vector>
+
+namespace Heroes {
+
+// A hero contributing to the influence field
+struct InfluenceSource {
+    RegionID region_id = INVALID_REGION_ID;
+    f32 weight = 0.0f;  // Renown (negative to subtract a previous contribution)
+};
+
+// Shared per-region hero influence field
+//
+// All heroes of one tier share a radius, so a tier is evaluated in a single
+// pass over the region grid instead of one radius query per hero. Distance is
+// the 8-neighbourhood step count (Chebyshev distance), i.e. the BFS distance
+// over World's grid adjacency. The falloff is split into nested square rings:
+//   K(d) = sum_{k=d..R} (K(k) - K(k+1)),   K(R+1) = 0
+// so each tier becomes R+1 box sums of a renown grid, each answered in O(1)
+// per cell from a summed-area table. Cost is O(cells * R) per tier no matter
+// how many heroes are in it, and the inner loops are contiguous and vectorize.
+// Small batches (incremental updates) are stamped per source instead.
+// Accumulation is linear, so a contribution is withdrawn by accumulating the
+// same source with negated weight.
+class InfluenceField {
+public:
+    InfluenceField();
+    ~InfluenceField();
+
+    // Size the field to the region grid and clear it
+    void Resize(u16 grid_width, u16 grid_height);
+
+    // Zero all influence values
+    void Clear();
+
+    // Add the influence of every source of one tier:
+    //   strength = (weight / base_divisor) / (1 + distance^distance_exponent)
+    // for regions within 'radius' steps of a source
+    void AccumulateTier(std::span<const InfluenceSource> sources, u8 radius,
+                        f32 base_divisor, f32 distance_exponent);
+
+    // Get total hero influence on a region
+    f32 GetInfluence(RegionID region_id) const;
+
+    // Get raw field (indexed by region ID)
+    const std::vector<f32>& GetValues() const { return values_; }
+
+    u16 GetGridWidth() const { return grid_width_; }
+    u16 GetGridHeight() const { return grid_height_; }
+
+private:
+    u16 grid_width_ = 0;
+    u16 grid_height_ = 0;
+
+    std::vector<f32> values_;
+
+    // Scratch buffers reused across tiers
+    std::vector<f64> summed_area_;  // Bounding box (+1 padding row/column)
+    std::vector<f32> falloff_;      // Strength per unit weight by distance
+
+    void StampSource(const InfluenceSource& source, i32 radius);
+    void SweepSummedArea(std::span<const InfluenceSource> sources, i32 radius,
+                         i32 x0, i32 y0, i32 x1, i32 y1);
+};
+
+} // namespace Heroes
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Simulation {
+
+// Compact per-cell state used while generating a world
+//
+// Each cell is a u8 type ID with side arrays for the source flag and source
+// parent; names are stored only for source cells. Passes retype cells in
+// place, and the generator builds the World's regions from the grid once at
+// the end. Cell indices are row-major and equal the final RegionIDs.
+class CellGrid {
+public:
+    using TypeID = u8;
+    static constexpr TypeID INVALID_TYPE = 0xFF;
+
+    // Type table (IDs are assigned in intern order; INVALID_TYPE once full)
+    TypeID InternType(const std::string& type);
+    TypeID FindType(const std::string& type) const;
+    const std::string& GetTypeName(TypeID type) const { return type_names_[type]; }
+    size_t GetTypeCount() const { return type_names_.size(); }
+    void ClearTypes();
+
+    // Size the grid with every cell set to type, not a source and without parent
+    void Reset(u16 width, u16 height, TypeID type);
+
+    u16 GetWidth() const { return width_; }
+    u16 GetHeight() const { return height_; }
+    u32 GetCellCount() const { return static_cast<u32>(types_.size()); }
+    u32 GetCell(u16 x, u16 y) const { return static_cast<u32>(y) * width_ + x; }
+    u16 GetCellX(u32 cell) const { return static_cast<u16>(cell % width_); }
+    u16 GetCellY(u32 cell) const { return static_cast<u16>(cell / width_); }
+
+    // Type at a grid position (INVALID_TYPE outside the grid)
+    TypeID GetType(u16 x, u16 y) const {
+        return (x < width_ && y < height_) ? types_[GetCell(x, y)] : INVALID_TYPE;
+    }
+    TypeID GetTypeAt(u32 cell) const { return types_[cell]; }
+    bool IsSource(u32 cell) const { return source_flags_[cell] != 0; }
+    RegionID GetSourceParent(u32 cell) const { return source_parents_[cell]; }
+    const std::string& GetName(u32 cell) const;
+
+    // Retype a cell as part of a source's area (drops any source flag and name)
+    void SetCell(u32 cell, TypeID type, RegionID source_parent);
+    // Retype a cell as a named source without parent
+    void SetSource(u32 cell, TypeID type, const std::string& name);
+    // Retype a cell, keeping its source flag, name and parent
+    void SetType(u32 cell, TypeID type) {
+        if (types_[cell] != type) {
+            changes_.push_back(cell);
+            ++change_count_;
+        }
+        types_[cell] = type;
+    }
+    void SetSourceParent(u32 cell, RegionID source_parent) { source_parents_[cell] = source_parent; }
+
+    // Row-major per-cell arrays, e.g. for serialization
+    std::span<const TypeID> GetTypes() const { return types_; }
+    std::span<const RegionID> GetSourceParents() const { return source_parents_; }
+    // Size the grid and copy types and source parents (no sources; add them
+    // with SetSource and restore their parents afterwards)
+    void Assign(u16 width, u16 height, std::span<const TypeID> types, std::span<const RegionID> source_parents);
+
+    // Cells whose type changed since the last ClearChanges (may repeat), for
+    // keeping derived per-cell data such as placement masks in sync
+    const std::vector<u32>& GetChanges() const { return changes_; }
+    void ClearChanges() { changes_.clear(); }
+    // Retypes over the grid's lifetime (not reset by Reset or ClearChanges)
+    u64 GetChangeCount() const { return change_count_; }
+
+private:
+    u16 width_ = 0;
+    u16 height_ = 0;
+
+    std::vector<TypeID> types_;
+    std::vector<u8> source_flags_;
+    std::vector<RegionID> source_parents_;
+    std::unordered_map<u32, std::string> names_;  // Source cells only
+    std::vector<u32> changes_;
+    u64 change_count_ = 0;
+
+    std::vector<std::string> type_names_;
+    std::unordered_map<std::string, TypeID> type_ids_;
+};
+
+} // namespace Simulation
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "Simulation/CellGrid.h"
+#include "Simulation/Region.h"
+#include "Simulation/World.h"
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Simulation {
+
+// Generated world whose regions are materialized tile by tile on demand
+//
+// The generator's final cell grid (a few bytes per cell) is kept for the whole
+// world; Region objects exist only for the tiles that have been acquired. When
+// a spill directory is set and more than the resident limit are loaded, the
+// least recently acquired tile is written to disk and dropped, then restored
+// from the grid and its spilled state on the next acquire. Without a spill
+// directory, tiles stay resident once loaded. RegionIDs are the same as in a
+// fully materialized World (row-major cell index).
+class ChunkedWorld {
+public:
+    // A square tile of regions (smaller on the right and bottom edges)
+    struct Chunk {
+        u16 chunk_x = 0;
+        u16 chunk_y = 0;
+        u16 origin_x = 0;  // Grid position of the top-left region
+        u16 origin_y = 0;
+        u16 width = 0;
+        u16 height = 0;
+        std::vector<Region> regions;  // Row-major within the tile
+
+        Region& GetRegionAtGrid(u16 grid_x, u16 grid_y) {
+            return regions[static_cast<u32>(grid_y - origin_y) * width + (grid_x - origin_x)];
+        }
+    };
+
+    // world carries sources, settlements and roads (and no regions)
+    ChunkedWorld(std::unique_ptr<World> world, CellGrid cells, u16 chunk_size);
+    ~ChunkedWorld();
+
+    u16 GetGridWidth() const { return world_->GetGridWidth(); }
+    u16 GetGridHeight() const { return world_->GetGridHeight(); }
+    f32 GetRegionSize() const { return world_->GetRegionSize(); }
+    u16 GetChunkSize() const { return chunk_size_; }
+    u16 GetChunksX() const { return chunks_x_; }
+    u16 GetChunksY() const { return chunks_y_; }
+
+    // Sources, settlements and roads (GetRegions() is empty)
+    const World& GetWorld() const { return *world_; }
+
+    // Final cell types and source data, readable without materializing regions
+    const CellGrid& GetCells() const { return cells_; }
+
+    // Residency: evict above max_chunks (0 = no limit) into directory
+    // (empty = never evict); eviction is checked on the next acquire. The
+    // directory is fixed once a chunk has been spilled.
+    void SetResidentLimit(u32 max_chunks) { resident_limit_ = max_chunks; }
+    bool SetSpillDirectory(const std::string& directory);
+    u32 GetResidentChunkCount() const { return static_cast<u32>(resident_order_.size()); }
+
+    // Load a tile (materializing or restoring it) and mark it most recently
+    // used. Pointers into a tile stay valid until it is evicted, which only
+    // happens while acquiring another tile.
+    Chunk* AcquireChunk(u16 chunk_x, u16 chunk_y);
+    Region* GetRegion(RegionID region_id);
+    Region* GetRegionAtGrid(u16 grid_x, u16 grid_y);
+
+    // Spill every resident tile (no-op without a spill directory)
+    void EvictAll();
+
+private:
+    std::unique_ptr<World> world_;
+    CellGrid cells_;
+    u16 chunk_size_ = 0;
+    u16 chunks_x_ = 0;
+    u16 chunks_y_ = 0;
+
+    std::vector<std::unique_ptr<Chunk>> chunks_;  // Indexed by chunk_y * chunks_x_ + chunk_x
+    std::vector<u8> spilled_;                     // Tile has state on disk
+    std::list<u32> resident_order_;               // Most recently acquired first
+    std::vector<std::list<u32>::iterator> resident_positions_;
+
+    u32 resident_limit_ = 0;
+    std::string spill_directory_;
+
+    void Materialize(Chunk& chunk) const;
+    bool Spill(u32 chunk_index);
+    bool Restore(Chunk& chunk, u32 chunk_index) const;
+    void EvictOverLimit(u32 keep_index);
+    std::string GetSpillPath(u32 chunk_index) const;
+};
+
+} // namespace Simulation
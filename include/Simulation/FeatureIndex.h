@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Simulation {
+
+// Nearest-feature lookup over a grid (exact Euclidean distance transform)
+//
+// Build marks a set of site cells and computes, for every cell, the nearest
+// site in O(width * height) using the separable lower-envelope transform
+// (column pass, then a row pass over parabolas). Queries are then O(1).
+// Between sites at the same distance, which one is kept is unspecified.
+class FeatureIndex {
+public:
+    static constexpr u32 NO_SITE = 0xFFFFFFFF;
+
+    // Rebuild from a row-major mask (non-zero = site)
+    void Build(u16 width, u16 height, std::span<const u8> sites);
+
+    u16 GetWidth() const { return width_; }
+    u16 GetHeight() const { return height_; }
+    bool HasSites() const { return has_sites_; }
+
+    // Nearest site cell to a grid position (NO_SITE if there are no sites)
+    u32 GetNearestSite(u16 x, u16 y) const {
+        return has_sites_ ? nearest_[static_cast<u32>(y) * width_ + x] : NO_SITE;
+    }
+    std::pair<u16, u16> GetNearestPosition(u16 x, u16 y) const;
+
+    // Squared Euclidean distance to the nearest site (0xFFFFFFFFFFFFFFFF without sites)
+    u64 GetSquaredDistance(u16 x, u16 y) const;
+
+private:
+    u16 width_ = 0;
+    u16 height_ = 0;
+    bool has_sites_ = false;
+    std::vector<u32> nearest_;
+
+    // Row pass scratch: column distances, envelope parabolas and boundaries
+    std::vector<u64> row_costs_;
+    std::vector<u32> row_sites_;
+    std::vector<u16> hull_columns_;
+    std::vector<f64> hull_starts_;
+};
+
+} // namespace Simulation
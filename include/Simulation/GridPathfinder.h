@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <array>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Simulation {
+
+// Reusable A* search over a 4-connected grid of terrain classes
+//
+// Each cell stores a u8 terrain class; step costs come from a per-class
+// table, so costs keep their full range without widening the grid. Per-cell
+// search state lives in flat arrays sized to the grid. Arrays are
+// invalidated by bumping a generation stamp, so a search only touches the
+// cells it visits. The open set is a 4-ary heap with lazy deletion.
+class GridPathfinder {
+public:
+    // Cost of a class that cannot be entered
+    static constexpr u16 BLOCKED = 0;
+
+    // Size the grid (every cell class 0); class costs are kept
+    void Resize(u16 width, u16 height);
+
+    u16 GetWidth() const { return width_; }
+    u16 GetHeight() const { return height_; }
+
+    // Cost of stepping onto a cell of a class (at least 1 unless BLOCKED,
+    // which every class starts as)
+    void SetClassCost(u8 terrain_class, u16 cost) { class_costs_[terrain_class] = cost; }
+    u16 GetClassCost(u8 terrain_class) const { return class_costs_[terrain_class]; }
+
+    void SetClass(u16 x, u16 y, u8 terrain_class) { classes_[GetCell(x, y)] = terrain_class; }
+    u8 GetClass(u16 x, u16 y) const { return classes_[GetCell(x, y)]; }
+
+    // Cost of stepping onto a cell
+    u16 GetCost(u16 x, u16 y) const { return class_costs_[classes_[GetCell(x, y)]]; }
+
+    // Cheapest path from start to end, excluding start and including end
+    // (false if end is unreachable; path is empty when start == end)
+    bool FindPath(std::pair<u16, u16> start, std::pair<u16, u16> end, std::vector<std::pair<u16, u16>>& path);
+
+    // Cheapest path to end from whichever start reaches it cheapest (e.g.
+    // every cell of an existing road network), excluding that start
+    bool FindPath(std::span<const std::pair<u16, u16>> starts, std::pair<u16, u16> end,
+                  std::vector<std::pair<u16, u16>>& path);
+
+    // Cells expanded by the last search
+    u32 GetExpandedCount() const { return expanded_count_; }
+
+private:
+    static constexpr u32 INVALID_CELL = 0xFFFFFFFF;
+
+    struct HeapEntry {
+        u32 f_cost;
+        u32 h_cost;
+        u32 cell;
+
+        // Lower f first; among equal f, the entry closer to the target
+        bool IsBefore(const HeapEntry& other) const {
+            return f_cost != other.f_cost ? f_cost < other.f_cost : h_cost < other.h_cost;
+        }
+    };
+
+    u16 width_ = 0;
+    u16 height_ = 0;
+    std::vector<u8> classes_;
+    std::array<u16, 256> class_costs_{};
+
+    // Search state, valid where the stamp equals generation_
+    std::vector<u32> g_costs_;
+    std::vector<u32> parents_;
+    std::vector<u32> seen_;
+    std::vector<u32> closed_;
+    u32 generation_ = 0;
+
+    std::vector<HeapEntry> heap_;
+    std::vector<u32> sources_;
+    u32 expanded_count_ = 0;
+
+    u32 GetCell(u16 x, u16 y) const { return static_cast<u32>(y) * width_ + x; }
+    void NextGeneration();
+
+    bool Search(std::span<const u32> sources, u32 target, std::vector<std::pair<u16, u16>>& path);
+
+    void PushHeap(HeapEntry entry);
+    HeapEntry PopHeap();
+};
+
+} // namespace Simulation
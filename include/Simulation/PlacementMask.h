@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "Simulation/CellGrid.h"
+#include <array>
+#include <span>
+#include <vector>
+
+namespace Simulation {
+
+// Placement rule of one region type, as lookup tables over cell types
+struct PlacementRule {
+    std::array<u8, 256> allowed_on{};    // Non-zero: may replace a cell of this type
+    std::array<u8, 256> incompatible{};  // Non-zero: may not touch a cell of this type (8-neighbourhood)
+    u8 blocked_rims = 0;                 // RIM_* bits of borders the type may not occupy
+
+    static constexpr u8 RIM_TOP = 1;
+    static constexpr u8 RIM_BOTTOM = 2;
+    static constexpr u8 RIM_LEFT = 4;
+    static constexpr u8 RIM_RIGHT = 8;
+};
+
+// Bitmap of the cells one region type may be placed on
+//
+// Rows are padded to whole 64-bit words. BuildAll evaluates every rule in
+// one sweep over the grid: each row is split into per-cell-type bit planes,
+// and a type's allowed / incompatible cells are ORs of planes, so the 3x3
+// neighbourhood test is a handful of shifted word ORs per 64 cells.
+// Afterwards, Update re-evaluates just the 3x3 block around a retyped cell.
+// Per-row counts make sampling the n-th placeable cell O(rows + row words).
+class PlacementMask {
+public:
+    static constexpr u32 NO_CELL = 0xFFFFFFFF;
+
+    // Build masks[t] for every rules[t] from the grid's current types
+    static void BuildAll(const CellGrid& cells, std::span<const PlacementRule> rules,
+                         std::vector<PlacementMask>& masks);
+
+    // Re-evaluate the cells whose placement depends on a retyped cell
+    void Update(const CellGrid& cells, u32 cell);
+
+    bool Test(u32 cell) const {
+        u32 x = cell % width_;
+        u32 y = cell / width_;
+        return (bits_[static_cast<size_t>(y) * words_per_row_ + (x >> 6)] >> (x & 63)) & 1;
+    }
+
+    // Placeable cells in rows [first_row, end_row), and the n-th of them in
+    // row-major order (NO_CELL if n is out of range)
+    u32 CountRows(u16 first_row, u16 end_row) const;
+    u32 FindNth(u16 first_row, u16 end_row, u32 n) const;
+
+    // Full rule check of one cell against the grid (what the bitmap caches)
+    bool Evaluate(const CellGrid& cells, u16 x, u16 y) const;
+
+private:
+    PlacementRule rule_;
+    u16 width_ = 0;
+    u16 height_ = 0;
+    u32 words_per_row_ = 0;
+    std::vector<u64> bits_;
+    std::vector<u32> row_counts_;
+
+    void SetBit(u16 x, u16 y, bool placeable);
+};
+
+} // namespace Simulation
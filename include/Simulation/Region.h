@@ -2,6 +2,8 @@
 
 #include "Core/Types.h"
 #include "Core/Config.h"
+#include <array>
+#include <iosfwd>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -45,18 +47,25 @@ public:
     void RemoveEntity(EntityID entity);
     bool IsAtCapacity() const;
     
-    // Resources
+    // Resources (fast path: slot index from RegionsConfig::GetResourceIndex)
+    f32 GetResource(ResourceIndex index) const;
+    void SetResource(ResourceIndex index, f32 value);
+    void ModifyResource(ResourceIndex index, f32 delta);
+    f32 GetResourceCapacity(ResourceIndex index) const;
+    void SetResourceCapacity(ResourceIndex index, f32 capacity);
+    
+    // Resources by name (resolves the slot index through the config)
     f32 GetResource(const std::string& resource_type) const;
     void SetResource(const std::string& resource_type, f32 value);
     void ModifyResource(const std::string& resource_type, f32 delta);
     
+    // Regenerate all resource slots towards capacity (fixed-width, branch-free)
+    void RegenerateResources(f32 amount_per_capacity);
+    
     // Traits
     void SetTrait(u8 category, u8 trait_id, bool value);
     bool GetTrait(u8 category, u8 trait_id) const;
-    
-    // Neighbors
-    void AddNeighbor(RegionID neighbor_id);
-    const std::vector<RegionID>& GetNeighbors() const { return neighbors_; }
+    u64 GetTraitMask(u8 category) const;
     
     // Position
     void SetPosition(f32 x, f32 y);
@@ -74,6 +83,13 @@ public:
     f32 GetSkillMean(SkillID skill_id) const;
     f32 GetSkillStdDev(SkillID skill_id) const;
     
+    // Mutable state (population, capacity, subtype, resources, traits, hero
+    // influences, skill distributions) in a raw binary form, for worlds that
+    // page regions to disk.
+    // Identity (ID, type, source data, position) is not included.
+    void WriteState(std::ostream& out) const;
+    bool ReadState(std::istream& in);
+    
 private:
     RegionID id_;
     std::string type_;
@@ -86,14 +102,12 @@ private:
     std::string name_;  // Name of the region (for source regions)
     RegionID source_parent_id_ = INVALID_REGION_ID;  // ID of source parent (if this is not a source)
     
-    // Resources
-    std::unordered_map<std::string, f32> resources_;
+    // Resources (fixed slots, unused slots have zero capacity)
+    std::array<f32, MAX_RESOURCES> resources_{};
+    std::array<f32, MAX_RESOURCES> resource_capacity_{};
     
     // Traits (bitfield per category)
-    std::vector<u64> traits_;  // 5 categories, each with bitfield
-    
-    // Neighbors
-    std::vector<RegionID> neighbors_;
+    std::array<u64, MAX_TRAIT_CATEGORIES> traits_{};
     
     // Position
     f32 x_ = 0.0f;
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <algorithm>
+#include <vector>
+
+namespace Simulation {
+
+// Poisson-disk placement of settlements over a grid
+//
+// Placed settlements are kept in a spatial hash whose buckets are
+// min_distance cells wide, so the spacing test reads the 3x3 buckets around a
+// position, and nearest-settlement queries search bucket rings outward.
+// Candidates wait in a max-heap. Scored by distance, a key is the distance
+// to the nearest settlement times a fixed per-candidate jitter; placing
+// settlements only lowers those keys, so TakeBest re-scores the top candidate
+// lazily and accepts it once it stays on top. Unscored, the key is the jitter
+// alone, which makes TakeBest plain dart throwing: random order, O(1) per
+// candidate, for filling a map with many settlements.
+class SettlementSampler {
+public:
+    static constexpr u32 NO_CELL = 0xFFFFFFFF;
+
+    // Clear settlements and candidates for a grid
+    void Reset(u16 grid_width, u16 grid_height, u16 min_distance);
+
+    // Record a placed settlement
+    void Insert(u16 x, u16 y);
+    u32 GetCount() const { return static_cast<u32>(points_.size()); }
+
+    // No settlement closer than min_distance
+    bool IsFarEnough(u16 x, u16 y) const;
+
+    // Squared distance to the nearest settlement (0xFFFFFFFFFFFFFFFF without any)
+    u64 GetNearestSquaredDistance(u16 x, u16 y) const;
+
+    // Candidates: jitter scales the distance score (e.g. [0.7, 1) to pick
+    // among the best rather than always the single farthest cell), or is the
+    // whole key when candidates are not scored by distance
+    void ClearCandidates(bool score_by_distance = true) {
+        heap_.clear();
+        heap_ready_ = true;
+        score_by_distance_ = score_by_distance;
+    }
+    void AddCandidate(u32 cell, f32 jitter);
+    size_t GetCandidateCount() const { return heap_.size(); }
+
+    // Remove and return the best-scored candidate that passes accept(cell)
+    // and, if spaced, is far enough from every settlement (NO_CELL when none
+    // is left). Candidates failing either test are dropped for good.
+    template <typename Accept>
+    u32 TakeBest(Accept&& accept, bool spaced = true);
+
+private:
+    struct Candidate {
+        f32 score = 0.0f;
+        f32 jitter = 0.0f;
+        u32 cell = 0;
+        u32 scored_at = 0;  // Settlement count when score was computed
+
+        bool operator<(const Candidate& other) const {
+            return score != other.score ? score < other.score : cell > other.cell;
+        }
+    };
+
+    // Linear search beats walking bucket rings while settlements are few
+    static constexpr u32 LINEAR_SEARCH_LIMIT = 64;
+
+    u16 grid_width_ = 0;
+    u16 grid_height_ = 0;
+    u16 min_distance_ = 1;
+    u16 buckets_x_ = 0;
+    u16 buckets_y_ = 0;
+
+    std::vector<std::pair<u16, u16>> points_;
+    std::vector<u32> bucket_heads_;  // Last point in each bucket
+    std::vector<u32> point_next_;    // Previous point in the same bucket
+
+    std::vector<Candidate> heap_;
+    bool heap_ready_ = true;
+    bool score_by_distance_ = true;
+
+    f32 Score(u32 cell, f32 jitter) const;
+};
+
+template <typename Accept>
+u32 SettlementSampler::TakeBest(Accept&& accept, bool spaced) {
+    if (!heap_ready_) {
+        std::make_heap(heap_.begin(), heap_.end());
+        heap_ready_ = true;
+    }
+    while (!heap_.empty()) {
+        std::pop_heap(heap_.begin(), heap_.end());
+        Candidate candidate = heap_.back();
+        heap_.pop_back();
+
+        u16 x = static_cast<u16>(candidate.cell % grid_width_);
+        u16 y = static_cast<u16>(candidate.cell / grid_width_);
+        if (spaced && !IsFarEnough(x, y)) {
+            continue;
+        }
+        // Stale score: re-score, and wait in the heap if it no longer leads
+        if (score_by_distance_ && candidate.scored_at != GetCount()) {
+            candidate.score = Score(candidate.cell, candidate.jitter);
+            candidate.scored_at = GetCount();
+            if (!heap_.empty() && candidate < heap_.front()) {
+                heap_.push_back(candidate);
+                std::push_heap(heap_.begin(), heap_.end());
+                continue;
+            }
+        }
+        if (accept(candidate.cell)) {
+            return candidate.cell;
+        }
+    }
+    return NO_CELL;
+}
+
+} // namespace Simulation
@@ -2,7 +2,15 @@
 
 #include "Simulation/WorldGenerator.h"
 #include "Simulation/RegionDefinition.h"
-#include "Utils/Random.h"
+#include "Simulation/GridPathfinder.h"
+#include "Simulation/CellGrid.h"
+#include "Simulation/FeatureIndex.h"
+#include "Simulation/PlacementMask.h"
+#include "Simulation/SettlementSampler.h"
+#include <chrono>
+#include <initializer_list>
+#include "Utils/RandomStream.h"
+#include <span>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -10,6 +18,8 @@
 
 namespace Simulation {
 
+class ChunkedWorld;
+
 // Standard world generator - creates a world with multiple passes
 class StandardWorldGenerator : public WorldGenerator {
 public:
@@ -19,59 +29,256 @@ public:
     // Generate a world
     std::unique_ptr<World> Generate(u16 grid_width, u16 grid_height, f32 region_size) override;
     
+    // Generate with regions materialized per chunk_size x chunk_size tile on
+    // demand, for worlds too large to hold one Region per cell (nullptr if
+    // no region definitions are loaded)
+    std::unique_ptr<ChunkedWorld> GenerateChunked(u16 grid_width, u16 grid_height, f32 region_size, u16 chunk_size);
+    
+    // World seed for the next Generate (0 = world.world_seed; if that is 0
+    // too, the seed kept in the world cache, else a new random seed)
+    void SetSeed(u64 seed) { requested_seed_ = seed; }
+    // Seed the last Generate used; the same seed reproduces the same world at any thread count
+    u64 GetSeed() const { return seed_; }
+    
+    // Run an extra pass after the named pass ("Initialize", "Coastal", a
+    // region type, "Rivers", "Settlements" or "Roads"; empty or unknown =
+    // after the last) in every following Generate
+    void AddPass(GenerationPass pass, const std::string& after = {});
+    
 private:
+    using TypeID = CellGrid::TypeID;
+    
+    // Cell types the passes refer to by name; interned first, so IDs are fixed
+    enum BuiltinType : TypeID {
+        TYPE_PLAINS,
+        TYPE_COASTAL,
+        TYPE_MOUNTAIN,
+        TYPE_FOREST,
+        TYPE_DESERT,
+        TYPE_WATER,
+        TYPE_RIVER,
+        TYPE_RIVER_SOURCE,
+        TYPE_URBAN,
+        TYPE_RURAL,
+        TYPE_ROAD,
+        BUILTIN_TYPE_COUNT
+    };
+    
+    // Placement rules of a region type, resolved to type IDs
+    struct TypeRules {
+        bool prevent_overwrite = false;
+        std::vector<TypeID> compatible;
+        std::vector<TypeID> incompatible;
+    };
+    
+    // Identifies this generator's output in cached worlds; bump whenever the
+    // world a seed produces changes
+    static constexpr u32 GENERATOR_VERSION = 5;
+    
+    // Run every pass on the cell grid, recording sources, settlements and
+    // roads in world; with the world cache enabled, resume after the latest pass
+    // whose state is in the world cache (false if there are no region
+    // definitions or a pass reads data no earlier pass writes)
+    bool RunPasses(World* world);
+    
+    // Built-in passes for the region definitions, with added passes inserted
+    std::vector<GenerationPass> BuildPipeline(
+        const std::unordered_map<std::string, RegionDefinition>& region_definitions);
+    
+    // Content hash of the type table and placement rules that every pass reads
+    u64 HashTypeTable() const;
+    
+    // Layout choices (DATA_LAYOUT) kept between passes and in cached pass state
+    void ResetLayoutState();
+    std::vector<u8> SaveLayoutState() const;
+    void RestoreLayoutState(std::span<const u8> state);
+    
+    // Intern all region types and resolve their placement rules
+    void BuildTypeTable(const std::unordered_map<std::string, RegionDefinition>& region_definitions);
+    
     // Pass 0: Initialize base layer
-    void Pass0_InitializePlains(World* world);
+    void Pass0_InitializePlains();
+    
+    // Build one Region per cell once generation is complete
+    void MaterializeRegions(World* world);
     
     // Determine generation order from region definitions
     std::vector<std::string> DetermineGenerationOrder(
         const std::unordered_map<std::string, RegionDefinition>& region_definitions);
     
+    // Random streams: one per pass (keyed further by type or source where noted)
+    enum GenerationStream : u64 {
+        STREAM_COASTAL = 1,
+        STREAM_SOURCES,        // Per region type
+        STREAM_EXPANSION,      // Per region type and source
+        STREAM_RIVER_SOURCES,
+        STREAM_RIVERS,         // Per river source
+        STREAM_SETTLEMENTS
+    };
+    
     // Core pass methods: create sources, then expand
     std::vector<RegionID> Pass_CreateSources(World* world, const std::string& region_type, const RegionDefinition& def);
-    void Pass_ExpandFromSource(World* world, RegionID source_id, const RegionDefinition& def);
     
-    // Expansion helpers
-    void ExpandCoastalInland(World* world, RegionID source_id, const RegionDefinition& def, u16 source_x, u16 source_y);
-    void ExpandStandardRegion(World* world, RegionID source_id, const RegionDefinition& def, u16 source_x, u16 source_y);
+    // Expand sources in parallel against the grid as of the call, then merge
+    // their claimed cells in source order
+    void ExpandSources(const std::vector<RegionID>& sources, const RegionDefinition& def);
+    
+    // State of one source expansion: cells seen (queued, claimed or found
+    // ineligible) and claimed as bitmaps, and the frontier of eligible
+    // unclaimed cells next to the claimed area. Sized to the grid once per
+    // thread; End clears only the words the expansion touched.
+    struct ExpansionScratch {
+        std::vector<u64> seen;
+        std::vector<u64> claimed;
+        std::vector<u32> touched;
+        std::vector<u32> frontier;
+        
+        void Begin(u32 cell_count) {
+            size_t words = (static_cast<size_t>(cell_count) + 63) / 64;
+            if (seen.size() < words) {
+                seen.resize(words, 0);
+                claimed.resize(words, 0);
+            }
+            frontier.clear();
+        }
+        void End() {
+            for (u32 cell : touched) {
+                seen[cell >> 6] = 0;
+                claimed[cell >> 6] = 0;
+            }
+            touched.clear();
+        }
+        bool IsSeen(u32 cell) const { return (seen[cell >> 6] >> (cell & 63)) & 1; }
+        void MarkSeen(u32 cell) {
+            seen[cell >> 6] |= u64{1} << (cell & 63);
+            touched.push_back(cell);
+        }
+        bool IsClaimed(u32 cell) const { return (claimed[cell >> 6] >> (cell & 63)) & 1; }
+        void MarkClaimed(u32 cell) { claimed[cell >> 6] |= u64{1} << (cell & 63); }
+        // O(1) removal: the last entry takes the removed one's place
+        u32 TakeFrontier(u32 index) {
+            u32 cell = frontier[index];
+            frontier[index] = frontier.back();
+            frontier.pop_back();
+            return cell;
+        }
+    };
+    static thread_local ExpansionScratch expansion_scratch_;
+    
+    // Expansion helpers (read the grid, append claimed cells; safe to run
+    // concurrently); false if the source ran out of cells before its target size
+    bool Pass_ExpandFromSource(RegionID source_id, const RegionDefinition& def,
+                               Utils::RandomStream& random, std::vector<u32>& claims);
+    bool ExpandCoastalInland(const RegionDefinition& def, u16 source_x, u16 source_y,
+                             Utils::RandomStream& random, std::vector<u32>& claims);
+    bool ExpandStandardRegion(const RegionDefinition& def, u16 source_x, u16 source_y,
+                              Utils::RandomStream& random, std::vector<u32>& claims);
+    void DiscoverNeighbors(ExpansionScratch& scratch, u32 cell, TypeID type);  // Queue eligible unseen neighbours
+    bool CanExpandInto(u16 x, u16 y, TypeID type);  // CanPlaceRegion plus per-type expansion limits
     
     // Special passes for regions that don't follow standard pattern
     void Pass_Coastal(World* world, const RegionDefinition& def);
     void Pass_Rivers(World* world, const std::unordered_map<std::string, RegionDefinition>& region_definitions);
     std::vector<RegionID> Pass_CreateRiverSources(World* world, const RegionDefinition& def);
-    void Pass_ExpandRiverFromSource(World* world, RegionID source_id, const RegionDefinition& def);
+    void Pass_ExpandRiverFromSource(RegionID source_id, const RegionDefinition& def);
     
     void Pass_Settlements(World* world, const std::unordered_map<std::string, RegionDefinition>& region_definitions);
+    
+    // Where a settlement of each kind may be founded
+    enum SettlementSite {
+        SITE_WATERSIDE,     // Next to Coastal or River
+        SITE_MOUNTAINSIDE,  // Next to Mountain
+        SITE_PLAINS,        // On Plains
+        SITE_FORESTSIDE     // Next to Forest
+    };
+    bool IsSettlementSite(u16 x, u16 y, SettlementSite site, TypeID type);  // Includes CanPlaceRegion
+    // Replace settlement_sampler_'s candidates with every matching cell,
+    // scored by distance to settlements or in random order
+    void GatherSettlementCandidates(SettlementSite site, TypeID type, bool score_by_distance);
+    // Found a settlement on the best candidate still matching site (false if none is left)
+    bool PlaceSettlement(World* world, std::vector<World::Settlement>& settlements,
+                         SettlementSite site, TypeID type, bool spaced,
+                         const std::string& name, const std::string& settlement_type);
     void Pass_Roads(World* world, const std::unordered_map<std::string, RegionDefinition>& region_definitions);
     
     // Utility methods
     std::string GetRandomName(const RegionDefinition& def);
     
     // Helper methods
-    Region* GetRegionAtGrid(World* world, u16 gx, u16 gy);
     bool IsOnRim(u16 x, u16 y) const;
     bool IsInNorthernHemisphere(u16 y) const;
-    std::vector<std::pair<u16, u16>> FindPath(World* world, 
-                                                const std::pair<u16, u16>& start,
-                                                const std::pair<u16, u16>& end);
-    std::vector<std::pair<u16, u16>> FindPathWithMerging(World* world,
-                                                          const std::pair<u16, u16>& start,
+    std::vector<std::pair<u16, u16>> FindPathWithMerging(const std::pair<u16, u16>& start,
                                                           const std::pair<u16, u16>& end);
     std::vector<std::pair<u16, u16>> FindRoadPath(World* world,
                                                    const std::pair<u16, u16>& start,
                                                    const std::pair<u16, u16>& end);
-    std::pair<u16, u16> FindNearestWaterSource(World* world, u16 x, u16 y);
-    std::pair<u16, u16> FindNearestNonCoastalBorder(World* world);
+    void BuildRoadCosts();  // Fill road_pathfinder_ classes and costs from cell types
+    void PlaceRoad(World* world, RegionID from_region, RegionID to_region,
+                   const std::vector<std::pair<u16, u16>>& path);  // Record road and convert its cells
+    void BuildFeatureIndex(FeatureIndex& index, std::initializer_list<TypeID> types);  // Sites = cells of these types
+    std::pair<u16, u16> FindNearestBorder(u16 x, u16 y) const;
     std::pair<u16, u16> CalculateCentroid(const std::vector<std::pair<u16, u16>>& positions);
-    bool CanPlaceRegion(World* world, u16 x, u16 y, const RegionDefinition& def);
+    bool CanPlaceRegion(u16 x, u16 y, TypeID type);  // Reads placement_masks_ (synced first if cells changed)
+    
+    // Placement masks: BuildPlacementMasks evaluates every type's rules over
+    // the whole grid (needed after coastal_borders_ changes); Sync applies
+    // the grid's change log, rebuilding instead when most cells changed
+    void BuildPlacementMasks();
+    void SyncPlacementMasks();
     
     // Grid dimensions
     u16 grid_width_ = 0;
     u16 grid_height_ = 0;
     f32 region_size_ = 0.0f;
     
-    // Random instance
-    Utils::Random* random_ = nullptr;
+    // Cell types and source data for the world being generated
+    CellGrid cells_;
+    std::vector<TypeRules> type_rules_;  // Indexed by TypeID
+    std::vector<PlacementRule> placement_rules_;  // Indexed by TypeID
+    std::vector<PlacementMask> placement_masks_;
+    
+    // Nearest-feature index, built by the pass that queries it
+    FeatureIndex coastal_index_;  // Coastal cells (river mouths)
+    std::vector<u8> feature_sites_;
+    
+    // Passes added with AddPass
+    std::vector<std::pair<std::string, GenerationPass>> added_passes_;
+    
+    // World seed and the stream of the running serial pass
+    u64 requested_seed_ = 0;
+    u64 seed_ = 0;
+    Utils::RandomStream random_;
+    
+    // Cells claimed by each source in the running ExpandSources, and
+    // whether it reached its target size
+    std::vector<std::vector<u32>> expansion_claims_;
+    std::vector<u8> expansion_complete_;
+    
+    // Report entry of the running pass: BeginPass appends it to report_,
+    // EndPass records its wall time and cell retypes
+    void BeginPass(const std::string& name);
+    void EndPass();
+    PassReport& CurrentPass() { return report_.passes.back(); }
+    std::chrono::steady_clock::time_point pass_start_time_;
+    u64 pass_start_changes_ = 0;
+    
+    // Road search context (costs kept in sync with placed roads)
+    GridPathfinder road_pathfinder_;
+    
+    // Settlement layout: minimum spacing between settlements, the lowest
+    // random factor on candidate scores (picks among near-best sites), and
+    // how far from the settlements' centroid the capital may move
+    static constexpr u16 SETTLEMENT_SPACING = 12;
+    static constexpr f32 SETTLEMENT_SCORE_JITTER = 0.7f;
+    static constexpr i32 CAPITAL_SEARCH_RADIUS = 10;
+    SettlementSampler settlement_sampler_;
+    
+    // Road network shape: near neighbours considered for redundant links, the
+    // tree detour (vs. straight distance) that justifies one, and at most one
+    // extra link per this many settlements
+    static constexpr size_t ROAD_CANDIDATE_NEIGHBORS = 4;
+    static constexpr f32 ROAD_DETOUR_FACTOR = 2.5f;
+    static constexpr size_t ROAD_EXTRA_LINK_DIVISOR = 8;
     
     // Desert hemisphere tracking (true = northern, false = southern)
     bool desert_northern_hemisphere_ = false;
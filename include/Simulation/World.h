@@ -4,6 +4,7 @@
 #include "Simulation/Region.h"
 #include <vector>
 #include <memory>
+#include <span>
 #include <string>
 
 namespace Simulation {
@@ -32,6 +33,21 @@ public:
     const std::vector<std::unique_ptr<Region>>& GetRegions() const { return regions_; }
     std::vector<std::unique_ptr<Region>>& GetRegions() { return regions_; }
     
+    // Regenerate resources for every region in one batched pass
+    void RegenerateResources(f32 delta_time);
+    
+    // Region adjacency (compressed sparse row, 8-neighbourhood on the grid)
+    // Built once after generation; edges can then be added/removed incrementally
+    void BuildAdjacency();
+    bool HasAdjacency() const { return !adjacency_offsets_.empty(); }
+    std::span<const RegionID> GetNeighbors(RegionID region_id) const;
+    void AddAdjacency(RegionID a, RegionID b);
+    void RemoveAdjacency(RegionID a, RegionID b);
+    
+    // Breadth-first range query over the adjacency (excludes the center region)
+    // Safe for concurrent const callers (visited stamps are per thread)
+    void GetRegionsInRange(RegionID center, u8 range, std::vector<RegionID>& out) const;
+    
     // Settlements (cities, villages, capital)
     struct Settlement {
         RegionID region_id;
@@ -67,6 +83,15 @@ private:
     std::vector<Settlement> settlements_;
     std::vector<Road> roads_;
     std::vector<RegionID> source_regions_;  // List of source region IDs
+    
+    // Adjacency in CSR form: row i spans [offsets[i], offsets[i] + counts[i]),
+    // with spare capacity up to offsets[i + 1] for incremental edges
+    std::vector<u32> adjacency_offsets_;
+    std::vector<u8> adjacency_counts_;
+    std::vector<RegionID> adjacency_targets_;
+    u8 adjacency_row_slack_ = 2;
+    
+    void GrowAdjacencyRows();
 };
 
 } // namespace Simulation
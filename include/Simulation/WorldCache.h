@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "Simulation/CellGrid.h"
+#include "Simulation/World.h"
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Simulation {
+
+// On-disk cache of generated worlds
+//
+// A cache file holds a generator's cell grid (type table, types, sources and
+// their parents), the world's source list, settlements and roads, and an
+// opaque block of generator state, in native byte order. Generators save the
+// final world and may also save the state after intermediate passes. Files
+// are named after their key and loaded through a read-only memory mapping;
+// a file whose header does not match the key exactly is treated as a miss.
+// Nothing expires on its own: generators remove the files a new pipeline
+// supersedes and trim the cache to a size limit, least recently used first.
+// The directory also keeps the seed drawn when no seed is configured, so a
+// restart reproduces (and loads) the same world.
+class WorldCache {
+public:
+    // Everything the cached state depends on
+    struct Key {
+        u16 grid_width = 0;
+        u16 grid_height = 0;
+        u64 seed = 0;
+        u64 content_hash = 0;       // Passes run so far and their inputs (definitions, config)
+        u32 generator_version = 0;  // Bumped when a seed's output changes
+    };
+
+    explicit WorldCache(std::string directory);
+
+    std::string GetPath(const Key& key) const;
+
+    // Write cells, world and generator state for key (false on I/O failure)
+    bool Save(const Key& key, const CellGrid& cells, const World& world,
+              std::span<const u8> generator_state) const;
+
+    // Fill cells, the (empty) world's sources, settlements and roads, and
+    // generator_state from the cache (false on a miss or an unreadable file)
+    bool Load(const Key& key, CellGrid& cells, World& world, std::vector<u8>& generator_state) const;
+
+    // Delete the files of key's grid size and seed that have another
+    // generator version or none of the given content hashes
+    void RemoveSuperseded(const Key& key, std::span<const u64> content_hashes) const;
+
+    // Delete least recently used files (by save or load) until the cache
+    // holds at most max_bytes; the most recent file is always kept
+    void Trim(u64 max_bytes) const;
+
+    // Seed kept for worlds generated without a configured seed (0 if none)
+    u64 LoadSeed() const;
+    bool SaveSeed(u64 seed) const;
+
+private:
+    std::string directory_;
+};
+
+} // namespace Simulation
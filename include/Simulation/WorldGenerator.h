@@ -2,10 +2,64 @@
 
 #include "Core/Types.h"
 #include "Simulation/World.h"
+#include "Simulation/CellGrid.h"
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace Simulation {
 
+// Data a generation pass reads or writes
+enum GenerationData : u32 {
+    DATA_CELLS = 1u << 0,        // Cell types and source parents
+    DATA_SOURCES = 1u << 1,      // Source cells, their names and the world's source list
+    DATA_SETTLEMENTS = 1u << 2,  // World settlements
+    DATA_ROADS = 1u << 3,        // World roads
+    DATA_LAYOUT = 1u << 4        // Generator layout choices (e.g. coastal borders, biome hemispheres)
+};
+
+// What a pass works on
+struct PassContext {
+    World* world = nullptr;
+    CellGrid* cells = nullptr;
+    u64 seed = 0;  // Derive the pass's random streams from this
+};
+
+// One step of a generation pipeline
+//
+// Passes run in order, and a pass may only read data an earlier pass wrote.
+// The content hash covers everything else its output depends on (region
+// definitions, config values), so a generator may restore the state after
+// a pass from cache when that pass and every pass before it hash the same.
+struct GenerationPass {
+    std::string name;
+    u32 inputs = 0;        // GenerationData read
+    u32 outputs = 0;       // GenerationData written
+    u64 content_hash = 0;
+    std::function<void(PassContext&)> run;
+};
+
+// Timing and work counts of one generation pass
+struct PassReport {
+    std::string name;
+    bool from_cache = false;       // Not run; its output was restored from the world cache
+    u64 content_hash = 0;          // Cache key of the state after this pass (0 if not a pipeline pass)
+    f64 wall_time_ms = 0.0;
+    u64 cells_changed = 0;         // Cell retypes (a cell retyped twice counts twice)
+    u32 attempts = 0;              // Placements tried: sources, border cells, settlements, roads
+    u32 rejections = 0;            // Attempts that placed nothing
+    u32 expansions_cut_short = 0;  // Sources that ran out of cells before their target size
+};
+
+// What the last generation did, pass by pass
+struct GenerationReport {
+    u64 seed = 0;
+    bool from_cache = false;  // Every pass was restored from the world cache
+    f64 total_time_ms = 0.0;
+    std::vector<PassReport> passes;
+};
+
 // Abstract base class for world generators
 class WorldGenerator {
 public:
@@ -15,7 +69,12 @@ public:
     // Generate a world with the given dimensions
     virtual std::unique_ptr<World> Generate(u16 grid_width, u16 grid_height, f32 region_size) = 0;
     
+    // Report of the last Generate (replaced by each call)
+    const GenerationReport& GetLastReport() const { return report_; }
+    
 protected:
+    GenerationReport report_;
+    
     // Helper to check if position is on the rim (outer edge)
     static bool IsOnRim(u16 x, u16 y, u16 grid_width, u16 grid_height) {
         return (x == 0 || x == grid_width - 1 || y == 0 || y == grid_height - 1);
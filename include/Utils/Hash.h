@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <string>
+#include <type_traits>
+
+namespace Utils {
+
+// Incremental 64-bit FNV-1a
+//
+// For content keys that must not change between runs or builds (random
+// stream keys, cache keys); values are hashed by their object
+// representation, so keys are only stable on one byte order.
+class Fnv1a {
+public:
+    Fnv1a& AddBytes(const void* data, size_t size) {
+        const u8* bytes = static_cast<const u8*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash_ ^= bytes[i];
+            hash_ *= PRIME;
+        }
+        return *this;
+    }
+
+    template <typename T>
+        requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+    Fnv1a& Add(T value) {
+        return AddBytes(&value, sizeof(T));
+    }
+
+    // Length-prefixed, so consecutive strings cannot run together
+    Fnv1a& Add(const std::string& value) {
+        Add(static_cast<u64>(value.size()));
+        return AddBytes(value.data(), value.size());
+    }
+
+    u64 Get() const { return hash_; }
+
+private:
+    static constexpr u64 OFFSET_BASIS = 0xCBF29CE484222325ull;
+    static constexpr u64 PRIME = 0x100000001B3ull;
+
+    u64 hash_ = OFFSET_BASIS;
+};
+
+} // namespace Utils
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <array>
+#include <span>
+
+namespace Utils {
+
+// Fixed-capacity vector stored inline (trivially copyable if T is)
+//
+// For small lists embedded in pooled records; pushing past capacity fails
+// instead of allocating.
+template<typename T, u8 Capacity>
+class InlineVector {
+public:
+    // Append a value (false if full)
+    bool PushBack(const T& value) {
+        if (size_ >= Capacity) {
+            return false;
+        }
+        data_[size_++] = value;
+        return true;
+    }
+
+    void Clear() { size_ = 0; }
+
+    u8 GetSize() const { return size_; }
+    bool IsEmpty() const { return size_ == 0; }
+    bool IsFull() const { return size_ >= Capacity; }
+    static constexpr u8 GetCapacity() { return Capacity; }
+
+    T& operator[](u8 index) { return data_[index]; }
+    const T& operator[](u8 index) const { return data_[index]; }
+
+    T* begin() { return data_.data(); }
+    T* end() { return data_.data() + size_; }
+    const T* begin() const { return data_.data(); }
+    const T* end() const { return data_.data() + size_; }
+
+    std::span<const T> AsSpan() const { return std::span<const T>(data_.data(), size_); }
+
+private:
+    std::array<T, Capacity> data_{};
+    u8 size_ = 0;
+};
+
+} // namespace Utils
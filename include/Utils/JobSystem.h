@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Utils {
+
+// Worker thread pool for data-parallel loops
+//
+// ParallelFor hands out indices from a shared counter; the calling thread
+// works too and returns once every index has run. Without workers (not
+// initialized, or parallel processing disabled) loops run inline. Calls from
+// inside a job also run inline. Top-level calls from different threads are
+// serialized: one loop owns the workers at a time.
+class JobSystem {
+public:
+    static JobSystem& GetInstance();
+
+    // Start worker threads (0 = one less than the hardware thread count)
+    void Initialize(u32 thread_count);
+
+    // Stop and join worker threads
+    void Shutdown();
+
+    // Number of worker threads (not counting the caller)
+    u32 GetWorkerCount() const { return static_cast<u32>(workers_.size()); }
+
+    // Run fn(index) for every index in [0, count) and wait for completion
+    void ParallelFor(u32 count, const std::function<void(u32)>& fn);
+
+private:
+    JobSystem() = default;
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    std::vector<std::thread> workers_;
+    std::mutex caller_mutex_;  // Held by the top-level ParallelFor that owns the workers
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable work_done_;
+
+    // Current loop (guarded by mutex_, except the index counter)
+    const std::function<void(u32)>* job_ = nullptr;
+    u32 job_count_ = 0;
+    std::atomic<u32> next_index_{0};
+    u64 job_generation_ = 0;
+    u32 busy_workers_ = 0;
+    bool stopping_ = false;
+
+    void WorkerLoop();
+    void RunJobIndices(const std::function<void(u32)>& fn, u32 count);
+};
+
+} // namespace Utils
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <mutex>
+#include <sstream>
+#include <string>
+
+namespace Utils {
+
+// Leveled, buffered console log
+//
+// Lines at or above the current level are appended to a buffer that is
+// written to stdout when it fills, when a warning or error is logged, on
+// Flush, and at exit; nothing flushes per line. Safe to call from several
+// threads. Use the LOG_* macros: building with DISABLE_LOGGING compiles them
+// out entirely, message formatting included.
+class Logger {
+public:
+    enum class Level : u8 {
+        Debug,
+        Info,
+        Warning,
+        Error,
+        Off
+    };
+
+    static Logger& GetInstance();
+
+    void SetLevel(Level level) { level_ = level; }
+    Level GetLevel() const { return level_; }
+    bool IsEnabled(Level level) const { return level >= level_ && level_ != Level::Off; }
+
+    // Append one line (no trailing newline needed)
+    void Write(Level level, const std::string& message);
+
+    // Write buffered lines to stdout
+    void Flush();
+
+private:
+    Logger() = default;
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    static constexpr size_t BUFFER_LIMIT = 16 * 1024;
+
+    Level level_ = Level::Info;
+    std::mutex mutex_;
+    std::string buffer_;
+
+    void FlushLocked();
+};
+
+#ifndef DISABLE_LOGGING
+#define LOG_AT(level, message)                                                     \
+    do {                                                                           \
+        if (::Utils::Logger::GetInstance().IsEnabled(level)) {                     \
+            std::ostringstream log_stream_;                                        \
+            log_stream_ << message;                                                \
+            ::Utils::Logger::GetInstance().Write(level, log_stream_.str());        \
+        }                                                                          \
+    } while (0)
+#else
+#define LOG_AT(level, message) ((void)0)
+#endif
+
+#define LOG_DEBUG(message) LOG_AT(::Utils::Logger::Level::Debug, message)
+#define LOG_INFO(message) LOG_AT(::Utils::Logger::Level::Info, message)
+#define LOG_WARNING(message) LOG_AT(::Utils::Logger::Level::Warning, message)
+#define LOG_ERROR(message) LOG_AT(::Utils::Logger::Level::Error, message)
+
+} // namespace Utils
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <span>
+#include <string>
+
+namespace Utils {
+
+// Read-only memory mapping of a whole file
+//
+// The mapping lives until Close or destruction; pages are loaded by the OS
+// as they are touched. An empty file opens with empty data.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map a file (false if it cannot be opened or mapped)
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return is_open_; }
+    std::span<const u8> GetData() const { return {data_, size_}; }
+
+private:
+    const u8* data_ = nullptr;
+    size_t size_ = 0;
+    bool is_open_ = false;
+#ifdef _WIN32
+    void* file_handle_ = nullptr;
+    void* mapping_handle_ = nullptr;
+#endif
+};
+
+} // namespace Utils
@@ -26,6 +26,9 @@ public:
     // Probability check
     bool RandomBool(f32 probability);  // Returns true with given probability
     
+    // Count of independent successes
+    u32 RandomBinomial(u32 trials, f32 probability);  // Successes in trials rolls
+    
     // Random selection from container
     template<typename Container>
     auto RandomChoice(const Container& container) -> decltype(*container.begin());
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Core/Types.h"
+
+namespace Utils {
+
+// Counter-based random stream (SplitMix64 over a keyed counter)
+//
+// A stream is fully determined by (seed, stream, index): the key mixes the
+// three, and the n-th draw is the SplitMix64 finalizer of key + n * gamma.
+// Independent streams can be derived for every pass and source and consumed
+// on any thread without shared state; the same inputs always reproduce the
+// same sequence. Ranges follow Random: RandomU32(min, max) is inclusive.
+class RandomStream {
+public:
+    RandomStream() = default;
+    RandomStream(u64 seed, u64 stream, u64 index = 0);
+
+    // Derive the key of a stream (also usable to mix seeds)
+    static u64 DeriveKey(u64 seed, u64 stream, u64 index);
+
+    u64 RandomU64() {
+        counter_ += GAMMA;
+        return Mix(key_ + counter_);
+    }
+    u32 RandomU32() { return static_cast<u32>(RandomU64() >> 32); }
+    u32 RandomU32(u32 min, u32 max);  // [min, max]
+    f32 RandomFloat() { return static_cast<f32>(RandomU64() >> 40) * (1.0f / 16777216.0f); }  // [0.0, 1.0)
+    f32 RandomFloat(f32 min, f32 max) { return min + (max - min) * RandomFloat(); }  // [min, max)
+    bool RandomBool(f32 probability) { return RandomFloat() < probability; }
+
+private:
+    static constexpr u64 GAMMA = 0x9E3779B97F4A7C15ull;
+
+    u64 key_ = 0;
+    u64 counter_ = 0;
+
+    static u64 Mix(u64 value) {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+};
+
+} // namespace Utils
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "Core/Types.h"
+#include <array>
+#include <vector>
+
+namespace Utils {
+
+// Hierarchical timing wheel
+//
+// Four levels of 256 slots each; level k holds items due within 256^(k+1)
+// ticks, bucketed by bits [8k, 8k+8) of their due tick. When the level below
+// wraps, a slot is cascaded down one level, so every item is moved at most
+// four times before it is due. Schedule is O(1); advancing is O(1) per tick
+// plus the items released, and skips ahead to the next cascade while the
+// lower levels are empty.
+// Items due beyond 2^32 ticks wait in an overflow list.
+//
+// There is no cancellation: owners record the tick they expect an item at
+// and ignore released entries that no longer match.
+template<typename T>
+class TimingWheel {
+public:
+    struct Entry {
+        Tick tick;
+        T item;
+    };
+
+    explicit TimingWheel(Tick start_tick = 0) { Reset(start_tick); }
+
+    // Drop all items and restart at a tick
+    void Reset(Tick start_tick) {
+        for (auto& level : slots_) {
+            for (auto& slot : level) {
+                slot.clear();
+            }
+        }
+        level_counts_.fill(0);
+        overdue_.clear();
+        overflow_.clear();
+        current_tick_ = start_tick;
+        size_ = 0;
+    }
+
+    // Schedule an item; items at or before the current tick are released by
+    // the next Advance
+    void Schedule(const T& item, Tick tick) {
+        ++size_;
+        if (tick <= current_tick_) {
+            overdue_.push_back(Entry{tick, item});
+            return;
+        }
+        Insert(Entry{tick, item});
+    }
+
+    // Advance to a tick, appending every item due by then to 'due' in tick
+    // order (overdue items first; order within one tick is unspecified)
+    void Advance(Tick tick, std::vector<Entry>& due) {
+        if (!overdue_.empty()) {
+            size_ -= overdue_.size();
+            due.insert(due.end(), overdue_.begin(), overdue_.end());
+            overdue_.clear();
+        }
+
+        while (current_tick_ < tick) {
+            if (size_ == 0) {
+                current_tick_ = tick;
+                break;
+            }
+            // Nothing happens until the lowest occupied level next cascades
+            u32 lowest = 0;
+            while (lowest < LEVEL_COUNT && level_counts_[lowest] == 0) {
+                ++lowest;
+            }
+            if (lowest > 0) {
+                Tick span_mask = (Tick(1) << (SLOT_BITS * lowest)) - 1;
+                Tick next_cascade = (current_tick_ | span_mask) + 1;
+                if (next_cascade > tick) {
+                    current_tick_ = tick;
+                    break;
+                }
+                current_tick_ = next_cascade - 1;
+            }
+
+            ++current_tick_;
+            for (u32 level = 1; level <= LEVEL_COUNT; ++level) {
+                if (((current_tick_ >> (SLOT_BITS * (level - 1))) & SLOT_MASK) != 0) {
+                    break;
+                }
+                if (level == LEVEL_COUNT) {
+                    CascadeOverflow();
+                } else {
+                    Cascade(level, (current_tick_ >> (SLOT_BITS * level)) & SLOT_MASK);
+                }
+            }
+
+            auto& slot = slots_[0][current_tick_ & SLOT_MASK];
+            if (!slot.empty()) {
+                level_counts_[0] -= slot.size();
+                size_ -= slot.size();
+                due.insert(due.end(), slot.begin(), slot.end());
+                slot.clear();
+            }
+        }
+    }
+
+    Tick GetCurrentTick() const { return current_tick_; }
+    size_t GetSize() const { return size_; }
+    bool IsEmpty() const { return size_ == 0; }
+
+private:
+    static constexpr u32 SLOT_BITS = 8;
+    static constexpr u32 SLOT_COUNT = 1u << SLOT_BITS;
+    static constexpr Tick SLOT_MASK = SLOT_COUNT - 1;
+    static constexpr u32 LEVEL_COUNT = 4;
+
+    std::array<std::array<std::vector<Entry>, SLOT_COUNT>, LEVEL_COUNT> slots_;
+    std::array<size_t, LEVEL_COUNT> level_counts_{};
+    std::vector<Entry> overdue_;
+    std::vector<Entry> overflow_;
+    std::vector<Entry> cascade_scratch_;
+    Tick current_tick_ = 0;
+    size_t size_ = 0;
+
+    // Place an entry due at or after the current tick (one due now lands in
+    // the bottom slot released this tick)
+    void Insert(const Entry& entry) {
+        Tick delta = entry.tick - current_tick_;
+        for (u32 level = 0; level < LEVEL_COUNT; ++level) {
+            if (delta < (Tick(1) << (SLOT_BITS * (level + 1)))) {
+                slots_[level][(entry.tick >> (SLOT_BITS * level)) & SLOT_MASK].push_back(entry);
+                ++level_counts_[level];
+                return;
+            }
+        }
+        overflow_.push_back(entry);
+    }
+
+    void Cascade(u32 level, Tick slot_index) {
+        auto& slot = slots_[level][slot_index];
+        if (slot.empty()) {
+            return;
+        }
+        level_counts_[level] -= slot.size();
+        cascade_scratch_.swap(slot);
+        for (const Entry& entry : cascade_scratch_) {
+            Insert(entry);
+        }
+        cascade_scratch_.clear();
+    }
+
+    void CascadeOverflow() {
+        if (overflow_.empty()) {
+            return;
+        }
+        std::vector<Entry> pending;
+        pending.swap(overflow_);
+        for (const Entry& entry : pending) {
+            Insert(entry);
+        }
+    }
+};
+
+} // namespace Utils
@@ -0,0 +1,57 @@
+#include "Components/Hero.h"
+#include "Core/Config.h"
+
+namespace Components {
+
+HeroTier GetTierForRenown(u16 renown, const Config::HeroesConfig::RenownConfig& config) {
+    // national_hero_threshold is the documented top of the National band and
+    // is only validated to lie below legendary_hero_threshold; renown in a
+    // configured gap between the two stays National
+    if (renown >= config.legendary_hero_threshold) {
+        return HeroTier::Legendary;
+    }
+    if (renown > config.regional_hero_threshold) {
+        return HeroTier::National;
+    }
+    if (renown > config.local_hero_threshold) {
+        return HeroTier::Regional;
+    }
+    return HeroTier::Local;
+}
+
+HeroTier Hero::GetTier() const {
+    return GetTierForRenown(renown, Config::Configuration::GetInstance().heroes.renown);
+}
+
+bool Hero::IsLocalHero() const {
+    return renown > 0 && GetTier() == HeroTier::Local;
+}
+
+bool Hero::IsRegionalHero() const {
+    return GetTier() == HeroTier::Regional;
+}
+
+bool Hero::IsNationalHero() const {
+    return GetTier() == HeroTier::National;
+}
+
+bool Hero::IsLegendaryHero() const {
+    return GetTier() == HeroTier::Legendary;
+}
+
+const char* Hero::GetTierName() const {
+    switch (GetTier()) {
+        case HeroTier::Local:
+            return "Local Hero";
+        case HeroTier::Regional:
+            return "Regional Hero";
+        case HeroTier::National:
+            return "National Hero";
+        case HeroTier::Legendary:
+            return "Legendary Hero";
+        default:
+            return "Hero";
+    }
+}
+
+} // namespace Components
@@ -1,4 +1,5 @@
 #include "Core/Config.h"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -43,7 +44,14 @@ bool Configuration::Validate() const {
     // Basic validation
     if (world.max_population == 0) return false;
     if (world.region_count == 0) return false;
+    if (world.ticks_per_year == 0) return false;
     if (skills.skill_count == 0) return false;
+    if (regions.resource_types.size() > MAX_RESOURCES) return false;
+    if (regions.trait_categories > MAX_TRAIT_CATEGORIES) return false;
+    const auto& renown = heroes.renown;
+    if (renown.local_hero_threshold >= renown.regional_hero_threshold) return false;
+    if (renown.regional_hero_threshold >= renown.national_hero_threshold) return false;
+    if (renown.national_hero_threshold >= renown.legendary_hero_threshold) return false;
     return true;
 }
 
@@ -67,6 +75,7 @@ void Configuration::ApplyDefaults() {
     world.world_height = 10000.0f;
     world.time_scale = 1.0f;
     world.tick_rate = 60.0f;
+    world.ticks_per_year = 365;
     
     performance.target_fps = 60.0f;
     performance.target_frame_time_ms = 16.67f;
@@ -91,6 +100,7 @@ void Configuration::ApplyDefaults() {
     regions.default_capacity = 10000;
     regions.capacity_variance = 0.5f;
     regions.resource_types = {"Food", "Materials", "Magic", "Trade"};
+    regions.IndexResourceTypes();
     regions.trait_categories = 5;
     regions.neighbor_connections_min = 2;
     regions.neighbor_connections_max = 6;
@@ -101,4 +111,20 @@ void Configuration::ApplyDefaults() {
     world.region_grid_height = 100;
 }
 
+void RegionsConfig::IndexResourceTypes() {
+    resource_indices.clear();
+    size_t count = std::min(resource_types.size(), static_cast<size_t>(MAX_RESOURCES));
+    for (size_t i = 0; i < count; ++i) {
+        resource_indices[resource_types[i]] = static_cast<ResourceIndex>(i);
+    }
+}
+
+ResourceIndex RegionsConfig::GetResourceIndex(const std::string& resource_type) const {
+    auto it = resource_indices.find(resource_type);
+    if (it != resource_indices.end()) {
+        return it->second;
+    }
+    return INVALID_RESOURCE_INDEX;
+}
+
 } // namespace Config
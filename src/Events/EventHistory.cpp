@@ -0,0 +1,338 @@
+#include "Events/EventHistory.h"
+#include <algorithm>
+#include <limits>
+
+namespace Events {
+
+namespace {
+
+void PutVarint(std::vector<u8>& out, u64 value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<u8>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<u8>(value));
+}
+
+u64 GetVarint(const u8*& in) {
+    u64 value = 0;
+    for (u32 shift = 0;; shift += 7) {
+        u8 byte = *in++;
+        value |= static_cast<u64>(byte & 0x7F) << shift;
+        if (byte < 0x80) {
+            return value;
+        }
+    }
+}
+
+// Signed delta from previous, zigzag-encoded so small steps either way stay short
+void PutDelta(std::vector<u8>& out, u64 value, u64& previous) {
+    i64 delta = static_cast<i64>(value - previous);
+    PutVarint(out, (static_cast<u64>(delta) << 1) ^ static_cast<u64>(delta >> 63));
+    previous = value;
+}
+
+u64 GetDelta(const u8*& in, u64& previous) {
+    u64 zigzag = GetVarint(in);
+    previous += (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+    return previous;
+}
+
+template<typename T>
+void InsertSorted(std::vector<T>& ids, T id) {
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it == ids.end() || *it != id) {
+        ids.insert(it, id);
+    }
+}
+
+// Drop one chunk's entries from the front of each of its IDs' posting lists
+template<typename Key, typename Postings>
+void DropPostings(std::unordered_map<Key, Postings>& postings, std::vector<Key>& ids) {
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    for (Key id : ids) {
+        auto it = postings.find(id);
+        if (it == postings.end()) {
+            continue;
+        }
+        it->second.DropFront();
+        if (it->second.chunks.empty()) {
+            postings.erase(it);
+        }
+    }
+}
+
+} // namespace
+
+void EventHistory::Summary::Add(const EventRecord& record) {
+    first_tick = std::min(first_tick, record.tick);
+    last_tick = std::max(last_tick, record.tick);
+}
+
+void EventHistory::Postings::Add(u32 sequence) {
+    chunks.push_back(sequence);
+}
+
+void EventHistory::Postings::DropFront() {
+    ++head;
+    // Compact once half the list is dropped, so drops stay O(1) amortized
+    if (head == chunks.size()) {
+        chunks.clear();
+        head = 0;
+    } else if (head * 2 >= chunks.size()) {
+        chunks.erase(chunks.begin(), chunks.begin() + head);
+        head = 0;
+    }
+}
+
+void EventHistory::Initialize(u32 capacity, u32 archive_capacity) {
+    u32 block_count = std::max(1u, (capacity + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    blocks_.assign(block_count, Block{});
+    for (Block& block : blocks_) {
+        block.records.reserve(BLOCK_SIZE);
+        block.summary = Summary{std::numeric_limits<Tick>::max(), 0};
+    }
+    oldest_block_ = 0;
+    block_count_ = 0;
+    recent_count_ = 0;
+
+    archive_.clear();
+    archive_capacity_ = archive_capacity;
+    archived_count_ = 0;
+    first_chunk_ = 0;
+    region_postings_.clear();
+    entity_postings_.clear();
+}
+
+void EventHistory::Record(const Event& event) {
+    if (blocks_.empty()) {
+        return;
+    }
+
+    u32 ring_size = static_cast<u32>(blocks_.size());
+    if (block_count_ == 0 || blocks_[(oldest_block_ + block_count_ - 1) % ring_size].records.size() >= BLOCK_SIZE) {
+        if (block_count_ == ring_size) {
+            Block& oldest = blocks_[oldest_block_];
+            ArchiveBlock(oldest);
+            recent_count_ -= static_cast<u32>(oldest.records.size());
+            oldest_block_ = (oldest_block_ + 1) % ring_size;
+            --block_count_;
+        }
+        Block& fresh = blocks_[(oldest_block_ + block_count_) % ring_size];
+        fresh.records.clear();
+        fresh.summary = Summary{std::numeric_limits<Tick>::max(), 0};
+        fresh.regions.clear();
+        fresh.entities.clear();
+        ++block_count_;
+    }
+
+    Block& newest = blocks_[(oldest_block_ + block_count_ - 1) % ring_size];
+    EventRecord& record = newest.records.emplace_back();
+    record.id = event.id;
+    record.tick = event.execution_tick;
+    record.type_id = event.type_id;
+    record.type = event.type;
+    record.priority = event.priority;
+    record.affected_entities = event.affected_entities;
+    record.affected_regions = event.affected_regions;
+    newest.summary.Add(record);
+    for (RegionID region_id : record.affected_regions) {
+        InsertSorted(newest.regions, region_id);
+    }
+    for (EntityID entity_id : record.affected_entities) {
+        InsertSorted(newest.entities, entity_id);
+    }
+    ++recent_count_;
+}
+
+const EventRecord& EventHistory::GetRecent(u32 index) const {
+    // Only the newest block can be partial, so ages map to blocks directly
+    const Block& block = blocks_[(oldest_block_ + index / BLOCK_SIZE) % blocks_.size()];
+    return block.records[index % BLOCK_SIZE];
+}
+
+void EventHistory::QueryTickRange(Tick first_tick, Tick last_tick, std::vector<EventRecord>& out) const {
+    Query<RegionID>(first_tick, last_tick, nullptr, nullptr, 0, [](const EventRecord&) { return true; }, out);
+}
+
+void EventHistory::QueryRegion(RegionID region_id, Tick first_tick, Tick last_tick,
+                               std::vector<EventRecord>& out) const {
+    Query(first_tick, last_tick, &region_postings_, &Block::regions, region_id, [region_id](const EventRecord& record) {
+        return std::find(record.affected_regions.begin(), record.affected_regions.end(), region_id) !=
+               record.affected_regions.end();
+    }, out);
+}
+
+void EventHistory::QueryEntity(EntityID entity_id, Tick first_tick, Tick last_tick,
+                               std::vector<EventRecord>& out) const {
+    Query(first_tick, last_tick, &entity_postings_, &Block::entities, entity_id, [entity_id](const EventRecord& record) {
+        return std::find(record.affected_entities.begin(), record.affected_entities.end(), entity_id) !=
+               record.affected_entities.end();
+    }, out);
+}
+
+size_t EventHistory::GetArchiveBytes() const {
+    size_t bytes = 0;
+    for (const ArchiveChunk& chunk : archive_) {
+        bytes += sizeof(ArchiveChunk) + chunk.ids.capacity() + chunk.ticks.capacity() +
+                 chunk.type_ids.capacity() * sizeof(u16) + chunk.kinds.capacity() +
+                 chunk.entity_counts.capacity() + chunk.entities.capacity() +
+                 chunk.region_counts.capacity() + chunk.regions.capacity();
+    }
+    for (const auto& [region_id, postings] : region_postings_) {
+        bytes += sizeof(region_id) + sizeof(postings) + postings.chunks.capacity() * sizeof(u32);
+    }
+    for (const auto& [entity_id, postings] : entity_postings_) {
+        bytes += sizeof(entity_id) + sizeof(postings) + postings.chunks.capacity() * sizeof(u32);
+    }
+    return bytes;
+}
+
+void EventHistory::ArchiveBlock(Block& block) {
+    if (archive_capacity_ == 0 || block.records.empty()) {
+        return;
+    }
+
+    u32 sequence = first_chunk_ + static_cast<u32>(archive_.size());
+    ArchiveChunk& chunk = archive_.emplace_back();
+    chunk.count = static_cast<u32>(block.records.size());
+    chunk.summary = block.summary;
+    chunk.type_ids.reserve(chunk.count);
+    chunk.kinds.reserve(chunk.count);
+    chunk.entity_counts.reserve(chunk.count);
+    chunk.region_counts.reserve(chunk.count);
+
+    u64 previous_id = 0;
+    u64 previous_tick = 0;
+    u64 previous_entity = 0;
+    u64 previous_region = 0;
+    for (const EventRecord& record : block.records) {
+        PutDelta(chunk.ids, record.id, previous_id);
+        PutDelta(chunk.ticks, record.tick, previous_tick);
+        chunk.type_ids.push_back(record.type_id);
+        chunk.kinds.push_back(static_cast<u8>(static_cast<u8>(record.type) | static_cast<u8>(record.priority) << 4));
+        chunk.entity_counts.push_back(record.affected_entities.GetSize());
+        for (EntityID entity_id : record.affected_entities) {
+            PutDelta(chunk.entities, entity_id, previous_entity);
+        }
+        chunk.region_counts.push_back(record.affected_regions.GetSize());
+        for (RegionID region_id : record.affected_regions) {
+            PutDelta(chunk.regions, region_id, previous_region);
+        }
+    }
+    chunk.ids.shrink_to_fit();
+    chunk.ticks.shrink_to_fit();
+    chunk.entities.shrink_to_fit();
+    chunk.regions.shrink_to_fit();
+
+    for (RegionID region_id : block.regions) {
+        region_postings_[region_id].Add(sequence);
+    }
+    for (EntityID entity_id : block.entities) {
+        entity_postings_[entity_id].Add(sequence);
+    }
+
+    archived_count_ += chunk.count;
+    while (archived_count_ > archive_capacity_) {
+        DropOldestChunk();
+    }
+}
+
+void EventHistory::DropOldestChunk() {
+    // The chunk's IDs come from its streams, so chunks need not store them twice
+    const ArchiveChunk& chunk = archive_.front();
+    std::vector<RegionID> region_ids;
+    std::vector<EntityID> entity_ids;
+    const u8* entities = chunk.entities.data();
+    const u8* regions = chunk.regions.data();
+    u64 previous_entity = 0;
+    u64 previous_region = 0;
+    for (u32 i = 0; i < chunk.count; ++i) {
+        for (u8 k = 0; k < chunk.entity_counts[i]; ++k) {
+            entity_ids.push_back(GetDelta(entities, previous_entity));
+        }
+        for (u8 k = 0; k < chunk.region_counts[i]; ++k) {
+            region_ids.push_back(static_cast<RegionID>(GetDelta(regions, previous_region)));
+        }
+    }
+    DropPostings(region_postings_, region_ids);
+    DropPostings(entity_postings_, entity_ids);
+
+    archived_count_ -= chunk.count;
+    archive_.pop_front();
+    ++first_chunk_;
+}
+
+void EventHistory::DecodeChunk(const ArchiveChunk& chunk, std::vector<EventRecord>& out) const {
+    out.resize(chunk.count);
+    const u8* ids = chunk.ids.data();
+    const u8* ticks = chunk.ticks.data();
+    const u8* entities = chunk.entities.data();
+    const u8* regions = chunk.regions.data();
+    u64 previous_id = 0;
+    u64 previous_tick = 0;
+    u64 previous_entity = 0;
+    u64 previous_region = 0;
+    for (u32 i = 0; i < chunk.count; ++i) {
+        EventRecord& record = out[i];
+        record.id = GetDelta(ids, previous_id);
+        record.tick = GetDelta(ticks, previous_tick);
+        record.type_id = chunk.type_ids[i];
+        record.type = static_cast<EventType>(chunk.kinds[i] & 0x0F);
+        record.priority = static_cast<EventPriority>(chunk.kinds[i] >> 4);
+        record.affected_entities.Clear();
+        for (u8 k = 0; k < chunk.entity_counts[i]; ++k) {
+            record.affected_entities.PushBack(GetDelta(entities, previous_entity));
+        }
+        record.affected_regions.Clear();
+        for (u8 k = 0; k < chunk.region_counts[i]; ++k) {
+            record.affected_regions.PushBack(static_cast<RegionID>(GetDelta(regions, previous_region)));
+        }
+    }
+}
+
+template<typename Key, typename Match>
+void EventHistory::Query(Tick first_tick, Tick last_tick, const std::unordered_map<Key, Postings>* postings,
+                         std::vector<Key> Block::*block_ids, Key key, Match match,
+                         std::vector<EventRecord>& out) const {
+    auto collect = [&](const std::vector<EventRecord>& records) {
+        for (const EventRecord& record : records) {
+            if (record.tick >= first_tick && record.tick <= last_tick && match(record)) {
+                out.push_back(record);
+            }
+        }
+    };
+    // Local scratch, so concurrent queries share nothing
+    std::vector<EventRecord> decoded;
+    auto scan_chunk = [&](const ArchiveChunk& chunk) {
+        if (chunk.summary.Overlaps(first_tick, last_tick)) {
+            DecodeChunk(chunk, decoded);
+            collect(decoded);
+        }
+    };
+
+    if (postings == nullptr) {
+        for (const ArchiveChunk& chunk : archive_) {
+            scan_chunk(chunk);
+        }
+    } else if (auto it = postings->find(key); it != postings->end()) {
+        const Postings& list = it->second;
+        for (size_t i = list.head; i < list.chunks.size(); ++i) {
+            scan_chunk(archive_[list.chunks[i] - first_chunk_]);
+        }
+    }
+
+    for (u32 i = 0; i < block_count_; ++i) {
+        const Block& block = blocks_[(oldest_block_ + i) % blocks_.size()];
+        if (!block.summary.Overlaps(first_tick, last_tick)) {
+            continue;
+        }
+        if (block_ids != nullptr && !std::binary_search((block.*block_ids).begin(), (block.*block_ids).end(), key)) {
+            continue;
+        }
+        collect(block.records);
+    }
+}
+
+} // namespace Events
@@ -0,0 +1,89 @@
+#include "Events/EventSpawner.h"
+#include "Utils/Random.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+namespace Events {
+
+namespace {
+// Above this many picks, duplicate checks use a hash set instead of a scan
+constexpr u32 LINEAR_PICK_LIMIT = 32;
+}
+
+void EventSpawner::Initialize() {
+    Initialize(Config::Configuration::GetInstance().events);
+}
+
+void EventSpawner::Initialize(const Config::EventsConfig& config) {
+    global_event_frequency_ = config.global_event_frequency;
+    regional_event_frequency_ = config.regional_event_frequency;
+    individual_event_frequency_ = config.individual_event_frequency;
+}
+
+bool EventSpawner::SpawnGlobal(Tick elapsed_ticks) {
+    return Utils::Random::GetInstance().RandomBool(GetStepProbability(global_event_frequency_, elapsed_ticks));
+}
+
+void EventSpawner::SpawnRegional(std::span<const RegionID> regions, std::vector<RegionID>& out, Tick elapsed_ticks) {
+    f32 probability = GetStepProbability(regional_event_frequency_, elapsed_ticks);
+    u32 count = Utils::Random::GetInstance().RandomBinomial(static_cast<u32>(regions.size()), probability);
+    SampleIndices(static_cast<u32>(regions.size()), count);
+    for (u32 index : picks_) {
+        out.push_back(regions[index]);
+    }
+}
+
+void EventSpawner::SpawnIndividual(RegionID region_id, u32 population, std::vector<IndividualSpawn>& out,
+                                   Tick elapsed_ticks) {
+    f32 probability = GetStepProbability(individual_event_frequency_, elapsed_ticks);
+    u32 count = Utils::Random::GetInstance().RandomBinomial(population, probability);
+    SampleIndices(population, count);
+    for (u32 index : picks_) {
+        out.push_back({region_id, index});
+    }
+}
+
+f32 EventSpawner::GetStepProbability(f32 per_tick, Tick elapsed_ticks) {
+    if (elapsed_ticks <= 1 || per_tick <= 0.0f || per_tick >= 1.0f) {
+        return per_tick;
+    }
+    return 1.0f - static_cast<f32>(std::pow(1.0 - per_tick, static_cast<f64>(elapsed_ticks)));
+}
+
+void EventSpawner::SampleIndices(u32 population, u32 count) {
+    picks_.clear();
+    if (count == 0) {
+        return;
+    }
+    if (count >= population) {
+        for (u32 i = 0; i < population; ++i) {
+            picks_.push_back(i);
+        }
+        return;
+    }
+
+    // Floyd: one draw per pick; a repeated draw takes the new upper index
+    Utils::Random& random = Utils::Random::GetInstance();
+    if (count <= LINEAR_PICK_LIMIT) {
+        for (u32 upper = population - count; upper < population; ++upper) {
+            u32 index = random.RandomU32(0, upper);
+            bool taken = std::find(picks_.begin(), picks_.end(), index) != picks_.end();
+            picks_.push_back(taken ? upper : index);
+        }
+    } else {
+        std::unordered_set<u32> taken;
+        taken.reserve(count);
+        for (u32 upper = population - count; upper < population; ++upper) {
+            u32 index = random.RandomU32(0, upper);
+            if (!taken.insert(index).second) {
+                index = upper;
+                taken.insert(index);
+            }
+            picks_.push_back(index);
+        }
+    }
+    std::sort(picks_.begin(), picks_.end());
+}
+
+} // namespace Events
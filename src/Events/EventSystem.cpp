@@ -0,0 +1,494 @@
+#include "Events/EventSystem.h"
+#include "Utils/JobSystem.h"
+#include "Utils/Random.h"
+#include <algorithm>
+#include <numeric>
+
+namespace Events {
+
+EventSystem::EventSystem() = default;
+
+EventSystem::~EventSystem() = default;
+
+void EventSystem::Initialize() {
+    config_ = Config::Configuration::GetInstance().events;
+    event_wheel_.Reset(0);
+
+    // The pool never grows, so scheduled records do not move
+    event_pool_.assign(config_.event_queue_size, Event{});
+    free_slots_.resize(config_.event_queue_size);
+    for (u32 i = 0; i < config_.event_queue_size; ++i) {
+        free_slots_[i] = config_.event_queue_size - 1 - i;
+    }
+    next_sequence_ = 1;
+
+    event_history_.Initialize(config_.event_history_size, config_.event_archive_size);
+    cascade_queue_.clear();
+    cascade_budget_ = 0;
+    cascade_stats_ = CascadeStats{};
+    current_tick_ = 0;
+}
+
+void EventSystem::Update(f32 delta_time, Tick current_tick) {
+    (void)delta_time;
+    current_tick_ = current_tick;
+    ProcessEventQueue(current_tick);
+}
+
+EventTypeID EventSystem::RegisterEventType(const std::string& name, std::initializer_list<EventField> fields) {
+    auto it = event_type_ids_.find(name);
+    if (it != event_type_ids_.end()) {
+        return it->second;
+    }
+    if (fields.size() > MAX_EVENT_FIELDS || event_types_.size() >= INVALID_EVENT_TYPE) {
+        return INVALID_EVENT_TYPE;
+    }
+
+    EventTypeID type_id = static_cast<EventTypeID>(event_types_.size());
+    event_types_.push_back({name, std::vector<EventField>(fields)});
+    event_type_ids_[name] = type_id;
+    return type_id;
+}
+
+EventTypeID EventSystem::GetEventTypeID(const std::string& name) const {
+    auto it = event_type_ids_.find(name);
+    if (it != event_type_ids_.end()) {
+        return it->second;
+    }
+    return INVALID_EVENT_TYPE;
+}
+
+const EventTypeInfo* EventSystem::GetEventTypeInfo(EventTypeID type_id) const {
+    if (type_id >= event_types_.size()) {
+        return nullptr;
+    }
+    return &event_types_[type_id];
+}
+
+u8 EventSystem::GetFieldSlot(EventTypeID type_id, const std::string& field_name) const {
+    const EventTypeInfo* info = GetEventTypeInfo(type_id);
+    if (!info) {
+        return INVALID_EVENT_FIELD;
+    }
+    for (size_t i = 0; i < info->fields.size(); ++i) {
+        if (info->fields[i].name == field_name) {
+            return static_cast<u8>(i);
+        }
+    }
+    return INVALID_EVENT_FIELD;
+}
+
+EventID EventSystem::ScheduleEvent(const Event& event, Tick delay_ticks) {
+    if (free_slots_.empty()) {
+        return INVALID_EVENT_ID;
+    }
+
+    u32 slot = free_slots_.back();
+    free_slots_.pop_back();
+
+    // Sequence in the high bits keeps IDs in scheduling order
+    EventID id = (static_cast<EventID>(next_sequence_++) << 32) | (static_cast<EventID>(slot) + 1);
+    Event& record = event_pool_[slot];
+    record = event;
+    record.id = id;
+    record.scheduled_tick = current_tick_;
+    record.execution_tick = current_tick_ + delay_ticks;
+    event_wheel_.Schedule(id, record.execution_tick);
+    return id;
+}
+
+EventID EventSystem::ScheduleImmediateEvent(const Event& event) {
+    return ScheduleEvent(event, 0);
+}
+
+bool EventSystem::CancelEvent(EventID event_id) {
+    // The wheel entry is dropped when it comes due
+    u32 slot = FindSlot(event_id);
+    if (slot == INVALID_EVENT_SLOT) {
+        return false;
+    }
+    event_pool_[slot].id = INVALID_EVENT_ID;
+    free_slots_.push_back(slot);
+    return true;
+}
+
+Event* EventSystem::GetEvent(EventID event_id) {
+    u32 slot = FindSlot(event_id);
+    return slot != INVALID_EVENT_SLOT ? &event_pool_[slot] : nullptr;
+}
+
+const Event* EventSystem::GetEvent(EventID event_id) const {
+    u32 slot = FindSlot(event_id);
+    return slot != INVALID_EVENT_SLOT ? &event_pool_[slot] : nullptr;
+}
+
+void EventSystem::RegisterHandler(const std::string& event_name, std::function<void(Event&)> handler, bool region_local) {
+    RegisterHandler(RegisterEventType(event_name), std::move(handler), region_local);
+}
+
+void EventSystem::RegisterHandler(EventTypeID type_id, std::function<void(Event&)> handler, bool region_local) {
+    if (type_id >= event_types_.size()) {
+        return;
+    }
+    if (handlers_.size() <= type_id) {
+        handlers_.resize(event_types_.size());
+        region_local_.resize(event_types_.size(), false);
+    }
+    handlers_[type_id] = std::move(handler);
+    region_local_[type_id] = region_local;
+}
+
+void EventSystem::RegisterBatchHandler(const std::string& event_name, std::function<void(std::span<Event>)> handler) {
+    RegisterBatchHandler(RegisterEventType(event_name), std::move(handler));
+}
+
+void EventSystem::RegisterBatchHandler(EventTypeID type_id, std::function<void(std::span<Event>)> handler) {
+    if (type_id >= event_types_.size()) {
+        return;
+    }
+    if (batch_handlers_.size() <= type_id) {
+        batch_handlers_.resize(event_types_.size());
+        batches_.resize(event_types_.size());
+    }
+    batch_handlers_[type_id] = std::move(handler);
+}
+
+void EventSystem::RegisterCascade(EventTypeID cause_type, EventTypeID effect_type) {
+    if (cause_type >= event_types_.size() || effect_type >= event_types_.size()) {
+        return;
+    }
+    if (cascades_.size() <= cause_type) {
+        cascades_.resize(event_types_.size());
+    }
+    cascades_[cause_type].push_back(effect_type);
+}
+
+EventID EventSystem::TriggerEvent(Event& cause, const Event& effect) {
+    u32 depth = cause.cascade_depth + 1u;
+    if (depth > config_.max_cascade_depth || depth > 255) {
+        ++cascade_stats_.dropped;
+        return INVALID_EVENT_ID;
+    }
+
+    Event follow_up = effect;
+    follow_up.cascade_depth = static_cast<u8>(depth);
+    follow_up.triggered_events.Clear();
+
+    EventID id;
+    if (cascade_budget_ > 0) {
+        // Runs later this tick without entering the pool
+        --cascade_budget_;
+        id = static_cast<EventID>(next_sequence_++) << 32;
+        follow_up.id = id;
+        follow_up.scheduled_tick = current_tick_;
+        follow_up.execution_tick = cause.execution_tick;
+        cascade_queue_.push_back(follow_up);
+    } else {
+        id = ScheduleEvent(follow_up, 1);
+        if (id == INVALID_EVENT_ID) {
+            ++cascade_stats_.dropped;
+            return INVALID_EVENT_ID;
+        }
+        ++cascade_stats_.spilled;
+    }
+
+    ++cascade_stats_.triggered;
+    cause.triggered_events.PushBack(id);
+    return id;
+}
+
+Event EventSystem::CreateGlobalEvent(const std::string& name) {
+    return CreateEvent(RegisterEventType(name), EventType::Global);
+}
+
+Event EventSystem::CreateRegionalEvent(const std::string& name, RegionID region_id) {
+    Event event = CreateEvent(RegisterEventType(name), EventType::Regional);
+    event.affected_regions.PushBack(region_id);
+    return event;
+}
+
+Event EventSystem::CreateIndividualEvent(const std::string& name, EntityID entity_id) {
+    Event event = CreateEvent(RegisterEventType(name), EventType::Individual);
+    event.affected_entities.PushBack(entity_id);
+    return event;
+}
+
+Event EventSystem::CreateEvent(EventTypeID type_id, EventType type) {
+    Event event;
+    event.type_id = type_id;
+    event.type = type;
+    return event;
+}
+
+const EventHistory& EventSystem::GetEventHistory() const {
+    return event_history_;
+}
+
+u32 EventSystem::GetActiveEventCount() const {
+    return static_cast<u32>(event_pool_.size() - free_slots_.size());
+}
+
+u32 EventSystem::FindSlot(EventID event_id) const {
+    u32 slot = static_cast<u32>(event_id & 0xFFFFFFFF) - 1;
+    if (event_id == INVALID_EVENT_ID || slot >= event_pool_.size() || event_pool_[slot].id != event_id) {
+        return INVALID_EVENT_SLOT;
+    }
+    return slot;
+}
+
+void EventSystem::ProcessEventQueue(Tick current_tick) {
+    cascade_stats_ = CascadeStats{};
+    if (!cascade_queue_.empty()) {
+        // Follow-ups triggered outside of Update
+        cascade_budget_ = config_.max_cascade_events_per_tick;
+        ProcessCascades();
+    }
+
+    due_events_.clear();
+    event_wheel_.Advance(current_tick, due_events_);
+    if (due_events_.empty()) {
+        return;
+    }
+
+    // Skip entries of cancelled events
+    ready_events_.clear();
+    for (const auto& entry : due_events_) {
+        u32 slot = FindSlot(entry.item);
+        if (slot != INVALID_EVENT_SLOT) {
+            const Event& event = event_pool_[slot];
+            ready_events_.push_back({entry.tick, event.priority, event.type_id, entry.item});
+        }
+    }
+
+    // Due tick first; priority only orders events due on the same tick
+    std::sort(ready_events_.begin(), ready_events_.end(), [](const ReadyEvent& a, const ReadyEvent& b) {
+        if (a.execution_tick != b.execution_tick) {
+            return a.execution_tick < b.execution_tick;
+        }
+        if (a.priority != b.priority) {
+            return a.priority > b.priority;
+        }
+        return a.id < b.id;
+    });
+
+    size_t begin = 0;
+    while (begin < ready_events_.size()) {
+        size_t end = begin + 1;
+        while (end < ready_events_.size() && ready_events_[end].execution_tick == ready_events_[begin].execution_tick) {
+            ++end;
+        }
+        ProcessDueTick(begin, end);
+        begin = end;
+    }
+}
+
+void EventSystem::ProcessDueTick(size_t begin, size_t end) {
+    cascade_budget_ = config_.max_cascade_events_per_tick;
+
+    // Batched types leave the queue together, so each batch is dispatched
+    // once at the position of its highest-priority event
+    for (size_t i = begin; i < end; ++i) {
+        const ReadyEvent& ready = ready_events_[i];
+        if (!HasBatchHandler(ready.type_id)) {
+            continue;
+        }
+        u32 slot = FindSlot(ready.id);
+        if (slot != INVALID_EVENT_SLOT) {
+            batches_[ready.type_id].push_back(event_pool_[slot]);
+            event_pool_[slot].id = INVALID_EVENT_ID;
+            free_slots_.push_back(slot);
+        }
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+        const ReadyEvent& ready = ready_events_[i];
+        if (IsRegionLocal(ready)) {
+            // Consecutive region-local events are independent of the serial
+            // events around them, so the whole run is split by region
+            size_t run_end = i + 1;
+            while (run_end < end && IsRegionLocal(ready_events_[run_end])) {
+                ++run_end;
+            }
+            ProcessRegionalRun(i, run_end);
+            i = run_end - 1;
+            continue;
+        }
+        if (HasBatchHandler(ready.type_id)) {
+            std::vector<Event>& batch = batches_[ready.type_id];
+            if (batch.empty()) {
+                continue;
+            }
+            batch_handlers_[ready.type_id](std::span<Event>(batch));
+            for (Event& event : batch) {
+                HandleCascadingEvents(event);
+                event_history_.Record(event);
+            }
+            batch.clear();
+            continue;
+        }
+
+        // A handler earlier in this tick may have cancelled it
+        u32 slot = FindSlot(ready.id);
+        if (slot == INVALID_EVENT_SLOT) {
+            continue;
+        }
+        Event event = event_pool_[slot];
+        event_pool_[slot].id = INVALID_EVENT_ID;
+        free_slots_.push_back(slot);
+
+        ExecuteEvent(event);
+        HandleCascadingEvents(event);
+        event_history_.Record(event);
+    }
+
+    ProcessCascades();
+}
+
+bool EventSystem::HasBatchHandler(EventTypeID type_id) const {
+    return type_id < batch_handlers_.size() && batch_handlers_[type_id];
+}
+
+bool EventSystem::IsRegionLocal(const ReadyEvent& ready) const {
+    if (ready.type_id >= region_local_.size() || !region_local_[ready.type_id] || HasBatchHandler(ready.type_id)) {
+        return false;
+    }
+    u32 slot = FindSlot(ready.id);
+    return slot != INVALID_EVENT_SLOT && !event_pool_[slot].affected_regions.IsEmpty();
+}
+
+void EventSystem::ProcessRegionalRun(size_t begin, size_t end) {
+    regional_events_.clear();
+    for (size_t i = begin; i < end; ++i) {
+        u32 slot = FindSlot(ready_events_[i].id);
+        regional_events_.push_back(event_pool_[slot]);
+        event_pool_[slot].id = INVALID_EVENT_ID;
+        free_slots_.push_back(slot);
+    }
+
+    // Events sharing a region join one group; each group's root is its
+    // first event, so groups keep execution order
+    u32 event_count = static_cast<u32>(regional_events_.size());
+    group_parents_.resize(event_count);
+    std::iota(group_parents_.begin(), group_parents_.end(), 0u);
+    region_events_.clear();
+    for (u32 e = 0; e < event_count; ++e) {
+        for (RegionID region_id : regional_events_[e].affected_regions) {
+            auto [it, inserted] = region_events_.emplace(region_id, e);
+            if (!inserted) {
+                u32 a = FindGroup(e);
+                u32 b = FindGroup(it->second);
+                group_parents_[std::max(a, b)] = std::min(a, b);
+            }
+        }
+    }
+
+    // Number groups by their first event and lay events out group by group
+    u32 group_count = 0;
+    group_ids_.resize(event_count);
+    group_offsets_.assign(1, 0);
+    for (u32 e = 0; e < event_count; ++e) {
+        u32 root = FindGroup(e);
+        if (root == e) {
+            group_ids_[e] = group_count++;
+            group_offsets_.push_back(0);
+        } else {
+            group_ids_[e] = group_ids_[root];
+        }
+        ++group_offsets_[group_ids_[e] + 1];
+    }
+    for (u32 g = 0; g < group_count; ++g) {
+        group_offsets_[g + 1] += group_offsets_[g];
+    }
+    group_events_.resize(event_count);
+    for (u32 e = 0; e < event_count; ++e) {
+        group_events_[group_offsets_[group_ids_[e]]++] = e;
+    }
+    for (u32 g = group_count; g > 0; --g) {
+        group_offsets_[g] = group_offsets_[g - 1];
+    }
+    group_offsets_[0] = 0;
+
+    Utils::JobSystem::GetInstance().ParallelFor(group_count, [this](u32 group) {
+        for (u32 i = group_offsets_[group]; i < group_offsets_[group + 1]; ++i) {
+            ExecuteEvent(regional_events_[group_events_[i]]);
+        }
+    });
+
+    // Follow-ups and history in execution order, independent of thread timing
+    for (Event& event : regional_events_) {
+        HandleCascadingEvents(event);
+        event_history_.Record(event);
+    }
+}
+
+u32 EventSystem::FindGroup(u32 event_index) {
+    while (group_parents_[event_index] != event_index) {
+        group_parents_[event_index] = group_parents_[group_parents_[event_index]];
+        event_index = group_parents_[event_index];
+    }
+    return event_index;
+}
+
+void EventSystem::ExecuteEvent(Event& event) {
+    if (event.type_id < handlers_.size() && handlers_[event.type_id]) {
+        handlers_[event.type_id](event);
+    }
+}
+
+void EventSystem::HandleCascadingEvents(Event& event) {
+    if (event.type_id >= cascades_.size()) {
+        return;
+    }
+    Utils::Random& random = Utils::Random::GetInstance();
+    for (EventTypeID effect_type : cascades_[event.type_id]) {
+        if (!random.RandomBool(config_.cascade_probability)) {
+            continue;
+        }
+        Event effect = CreateEvent(effect_type, event.type);
+        effect.priority = event.priority;
+        effect.affected_entities = event.affected_entities;
+        effect.affected_regions = event.affected_regions;
+        TriggerEvent(event, effect);
+    }
+}
+
+void EventSystem::ProcessCascades() {
+    // One level per pass: follow-ups triggered while a level runs wait for
+    // the next pass, so a deep chain cannot starve its siblings
+    while (!cascade_queue_.empty()) {
+        cascade_level_.swap(cascade_queue_);
+        cascade_queue_.clear();
+        cascade_stats_.largest_level = std::max(cascade_stats_.largest_level, static_cast<u32>(cascade_level_.size()));
+        cascade_stats_.executed += static_cast<u32>(cascade_level_.size());
+
+        for (const Event& event : cascade_level_) {
+            if (HasBatchHandler(event.type_id)) {
+                batches_[event.type_id].push_back(event);
+            }
+        }
+
+        for (Event& event : cascade_level_) {
+            cascade_stats_.deepest = std::max(cascade_stats_.deepest, event.cascade_depth);
+            if (HasBatchHandler(event.type_id)) {
+                std::vector<Event>& batch = batches_[event.type_id];
+                if (batch.empty()) {
+                    continue;
+                }
+                batch_handlers_[event.type_id](std::span<Event>(batch));
+                for (Event& batched : batch) {
+                    HandleCascadingEvents(batched);
+                    event_history_.Record(batched);
+                }
+                batch.clear();
+                continue;
+            }
+
+            ExecuteEvent(event);
+            HandleCascadingEvents(event);
+            event_history_.Record(event);
+        }
+        cascade_level_.clear();
+    }
+}
+
+} // namespace Events
@@ -10,6 +10,7 @@
 #include "Scenes/WorldScene.h"
 #include "Scenes/WorldSidebarScene.h"
 #include "ECS/System.h"
+#include "Utils/JobSystem.h"
 
 namespace Game {
 
@@ -74,6 +75,8 @@ void Game::Run() {
 void Game::Shutdown() {
     is_running_ = false;
     
+    Utils::JobSystem::GetInstance().Shutdown();
+    
     if (platform_manager_) {
         platform_manager_->Shutdown();
         platform_manager_.reset();
@@ -221,6 +224,12 @@ void Game::InitializeECS() {
 }
 
 void Game::InitializeSystems() {
+    // Worker threads for parallel system updates
+    const Config::PerformanceConfig& performance = config_->performance;
+    if (performance.parallel_processing) {
+        Utils::JobSystem::GetInstance().Initialize(performance.thread_count_override ? performance.thread_count : 0);
+    }
+    
     // TODO: Initialize game systems
 }
 
@@ -0,0 +1,416 @@
+#include "Heroes/HeroSystem.h"
+#include "Simulation/World.h"
+#include "Simulation/LODSystem.h"
+#include "Core/Config.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Heroes {
+
+HeroSystem::HeroSystem() = default;
+
+HeroSystem::~HeroSystem() = default;
+
+void HeroSystem::Initialize() {
+    config_ = Config::Configuration::GetInstance().heroes;
+    heroes_.Clear();
+    dirty_heroes_.clear();
+    for (auto& sources : removed_sources_) {
+        sources.clear();
+    }
+    current_tick_ = 0;
+    last_influence_update_tick_ = 0;
+    incremental_updates_since_rebuild_ = 0;
+
+    const auto& world_config = Config::Configuration::GetInstance().world;
+    decay_wheel_.Reset(0);
+    decay_delay_ticks_ = static_cast<Tick>(config_.renown.decay_inactivity_years * static_cast<f32>(world_config.ticks_per_year));
+    decay_ticks_per_point_ = 0.0;
+    if (config_.renown.decay_enabled && config_.renown.decay_rate_per_year > 0.0f) {
+        decay_ticks_per_point_ = static_cast<f64>(world_config.ticks_per_year) / config_.renown.decay_rate_per_year;
+    }
+}
+
+void HeroSystem::SetWorld(const Simulation::World* world) {
+    world_ = world;
+    if (world_) {
+        influence_field_.Resize(world_->GetGridWidth(), world_->GetGridHeight());
+    } else {
+        influence_field_.Resize(0, 0);
+    }
+    RebuildHeroInfluences();
+}
+
+void HeroSystem::Update(f32 delta_time, Tick current_tick) {
+    (void)delta_time;
+    current_tick_ = current_tick;
+
+    if (config_.renown.decay_enabled) {
+        UpdateRenownDecay(current_tick);
+    }
+
+    if (current_tick - last_influence_update_tick_ >= config_.influence.influence_update_frequency) {
+        UpdateHeroInfluences();
+        last_influence_update_tick_ = current_tick;
+    }
+}
+
+bool HeroSystem::CheckAndPromote(EntityID entity, u16 new_renown) {
+    if (new_renown < config_.renown.min_renown) {
+        return false;
+    }
+
+    u32 row = heroes_.Find(entity);
+    if (row != INVALID_HERO_ROW) {
+        // Decay owed so far counts as applied, later decay continues from it
+        row = CatchUpDecay(row);
+        if (row != INVALID_HERO_ROW) {
+            SetRenown(row, new_renown);
+            return false;
+        }
+    }
+
+    row = heroes_.Insert(entity, Components::GetTierForRenown(new_renown, config_.renown));
+    heroes_.SetRenown(row, new_renown);
+    heroes_.SetPromotionTick(row, current_tick_);
+    heroes_.SetLastAccomplishmentTick(row, current_tick_);
+    MarkInfluenceDirty(row);
+    ScheduleDecay(row);
+    return true;
+}
+
+void HeroSystem::AwardRenown(EntityID entity, u16 amount, const std::string& source) {
+    (void)source;  // TODO: Record renown sources for hero history
+
+    u32 row = heroes_.Find(entity);
+    if (row != INVALID_HERO_ROW) {
+        row = CatchUpDecay(row);
+    }
+    u32 current = row != INVALID_HERO_ROW ? heroes_.GetRenown(row) : 0;
+
+    u16 new_renown = static_cast<u16>(std::min<u32>(current + amount, config_.renown.max_renown));
+    if (row != INVALID_HERO_ROW) {
+        row = SetRenown(row, new_renown);
+        heroes_.SetLastAccomplishmentTick(row, current_tick_);
+        heroes_.SetDecayApplied(row, 0);
+        ScheduleDecay(row);
+    } else {
+        CheckAndPromote(entity, new_renown);
+    }
+}
+
+void HeroSystem::SetHeroRegion(EntityID entity, RegionID region_id) {
+    u32 row = heroes_.Find(entity);
+    if (row != INVALID_HERO_ROW) {
+        row = CatchUpDecay(row);
+    }
+    if (row == INVALID_HERO_ROW || heroes_.GetRegion(row) == region_id) {
+        return;
+    }
+    heroes_.SetRegion(row, region_id);
+    MarkInfluenceDirty(row);
+}
+
+void HeroSystem::RemoveHero(EntityID entity) {
+    u32 row = heroes_.Find(entity);
+    if (row == INVALID_HERO_ROW) {
+        return;
+    }
+
+    // The row is gone by the next update, so queue the withdrawal now
+    u16 applied_renown = heroes_.GetAppliedRenown(row);
+    RegionID applied_region = heroes_.GetAppliedRegion(row);
+    if (world_ && applied_renown > 0 && applied_region != INVALID_REGION_ID) {
+        u8 tier = static_cast<u8>(Components::GetTierForRenown(applied_renown, config_.renown));
+        removed_sources_[tier].push_back({applied_region, -static_cast<f32>(applied_renown)});
+    }
+    if (heroes_.IsInfluenceDirty(row)) {
+        dirty_heroes_.erase(std::find(dirty_heroes_.begin(), dirty_heroes_.end(), entity));
+    }
+    heroes_.Remove(row);
+}
+
+bool HeroSystem::GetHero(EntityID entity, Components::Hero& out_hero) const {
+    u32 row = heroes_.Find(entity);
+    if (row == INVALID_HERO_ROW) {
+        return false;
+    }
+    out_hero.entity_id = entity;
+    // Include decay not yet applied to heroes in lazily updated regions
+    u16 pending_decay = static_cast<u16>(GetDecayOwed(row, current_tick_) - heroes_.GetDecayApplied(row));
+    out_hero.renown = static_cast<u16>(heroes_.GetRenown(row) - std::min(pending_decay, heroes_.GetRenown(row)));
+    out_hero.influence_radius = GetTierRadius(heroes_.GetTier(row));
+    out_hero.hero_type = heroes_.GetHeroType(row);
+    out_hero.region_id = heroes_.GetRegion(row);
+    out_hero.last_accomplishment_tick = heroes_.GetLastAccomplishmentTick(row);
+    out_hero.promotion_tick = heroes_.GetPromotionTick(row);
+    return true;
+}
+
+bool HeroSystem::IsHero(EntityID entity) const {
+    return heroes_.Find(entity) != INVALID_HERO_ROW;
+}
+
+u16 HeroSystem::CalculateRenownFromSkills(const Components::Skills& skills) const {
+    // TODO: Implement skill-based renown
+    (void)skills;
+    return 0;
+}
+
+void HeroSystem::AwardCombatRenown(EntityID entity, const std::string& achievement_type, u16 base_amount) {
+    AwardRenown(entity, base_amount, achievement_type);
+}
+
+void HeroSystem::AwardSkillRenown(EntityID entity, SkillID skill_id, u8 level) {
+    // TODO: Implement skill milestone renown
+    (void)entity;
+    (void)skill_id;
+    (void)level;
+}
+
+void HeroSystem::AwardLineageRenown(EntityID entity, EntityID parent1, EntityID parent2) {
+    // TODO: Implement lineage renown
+    (void)entity;
+    (void)parent1;
+    (void)parent2;
+}
+
+void HeroSystem::AwardAccomplishmentRenown(EntityID entity, const std::string& accomplishment_type) {
+    // TODO: Implement accomplishment renown
+    (void)entity;
+    (void)accomplishment_type;
+}
+
+void HeroSystem::UpdateHeroInfluences() {
+    if (!world_) {
+        return;
+    }
+
+    // Past half the heroes, or when drift is due for a resync, a rebuild is
+    // as cheap as the delta
+    if (dirty_heroes_.size() * 2 > heroes_.GetCount() ||
+        incremental_updates_since_rebuild_ >= INFLUENCE_REBUILD_INTERVAL) {
+        RebuildHeroInfluences();
+        return;
+    }
+
+    bool has_changes = !dirty_heroes_.empty();
+    for (u8 tier = 0; tier < Components::HERO_TIER_COUNT; ++tier) {
+        tier_sources_[tier].swap(removed_sources_[tier]);
+        removed_sources_[tier].clear();
+        has_changes = has_changes || !tier_sources_[tier].empty();
+    }
+    if (!has_changes) {
+        return;
+    }
+
+    // Withdraw each dirty hero's applied contribution and add its current one
+    for (EntityID entity : dirty_heroes_) {
+        u32 row = heroes_.Find(entity);
+        u16 applied_renown = heroes_.GetAppliedRenown(row);
+        RegionID applied_region = heroes_.GetAppliedRegion(row);
+        if (applied_renown > 0 && applied_region != INVALID_REGION_ID) {
+            u8 tier = static_cast<u8>(Components::GetTierForRenown(applied_renown, config_.renown));
+            tier_sources_[tier].push_back({applied_region, -static_cast<f32>(applied_renown)});
+        }
+        u16 renown = heroes_.GetRenown(row);
+        RegionID region = heroes_.GetRegion(row);
+        if (renown > 0 && region != INVALID_REGION_ID) {
+            u8 tier = static_cast<u8>(heroes_.GetTier(row));
+            tier_sources_[tier].push_back({region, static_cast<f32>(renown)});
+        }
+        heroes_.SetApplied(row, region, renown);
+        heroes_.SetInfluenceDirty(row, false);
+    }
+    dirty_heroes_.clear();
+
+    for (u8 tier = 0; tier < Components::HERO_TIER_COUNT; ++tier) {
+        influence_field_.AccumulateTier(tier_sources_[tier],
+                                        GetTierRadius(static_cast<Components::HeroTier>(tier)),
+                                        config_.influence.base_influence_divisor,
+                                        config_.influence.distance_modifier_exponent);
+    }
+    ++incremental_updates_since_rebuild_;
+}
+
+void HeroSystem::RebuildHeroInfluences() {
+    for (u8 tier = 0; tier < Components::HERO_TIER_COUNT; ++tier) {
+        tier_sources_[tier].clear();
+        removed_sources_[tier].clear();
+    }
+    dirty_heroes_.clear();
+    incremental_updates_since_rebuild_ = 0;
+
+    // Rows are already grouped by tier, so each tier is one contiguous range
+    for (u8 tier = 0; tier < Components::HERO_TIER_COUNT; ++tier) {
+        u32 end = heroes_.GetTierEnd(static_cast<Components::HeroTier>(tier));
+        for (u32 row = heroes_.GetTierBegin(static_cast<Components::HeroTier>(tier)); row < end; ++row) {
+            u16 renown = heroes_.GetRenown(row);
+            RegionID region = heroes_.GetRegion(row);
+            heroes_.SetApplied(row, region, renown);
+            heroes_.SetInfluenceDirty(row, false);
+            if (renown > 0 && region != INVALID_REGION_ID) {
+                tier_sources_[tier].push_back({region, static_cast<f32>(renown)});
+            }
+        }
+    }
+
+    influence_field_.Clear();
+    if (!world_) {
+        return;
+    }
+    for (u8 tier = 0; tier < Components::HERO_TIER_COUNT; ++tier) {
+        influence_field_.AccumulateTier(tier_sources_[tier],
+                                        GetTierRadius(static_cast<Components::HeroTier>(tier)),
+                                        config_.influence.base_influence_divisor,
+                                        config_.influence.distance_modifier_exponent);
+    }
+}
+
+f32 HeroSystem::GetRegionInfluence(RegionID region_id) const {
+    return influence_field_.GetInfluence(region_id);
+}
+
+const char* HeroSystem::GetHeroTier(u16 renown) const {
+    switch (Components::GetTierForRenown(renown, config_.renown)) {
+        case Components::HeroTier::Local:
+            return "Local Hero";
+        case Components::HeroTier::Regional:
+            return "Regional Hero";
+        case Components::HeroTier::National:
+            return "National Hero";
+        case Components::HeroTier::Legendary:
+            return "Legendary Hero";
+        default:
+            return "Hero";
+    }
+}
+
+u8 HeroSystem::GetInfluenceRadius(u16 renown) const {
+    return GetTierRadius(Components::GetTierForRenown(renown, config_.renown));
+}
+
+f32 HeroSystem::CalculateInfluenceStrength(u16 renown, u8 distance_in_regions) const {
+    if (distance_in_regions > GetInfluenceRadius(renown) || config_.influence.base_influence_divisor <= 0.0f) {
+        return 0.0f;
+    }
+
+    f32 distance_modifier = 1.0f / (1.0f + std::pow(static_cast<f32>(distance_in_regions),
+                                                    config_.influence.distance_modifier_exponent));
+    return (static_cast<f32>(renown) / config_.influence.base_influence_divisor) * distance_modifier;
+}
+
+void HeroSystem::UpdateRenownDecay(Tick current_tick) {
+    if (decay_ticks_per_point_ <= 0.0) {
+        return;
+    }
+
+    decay_due_.clear();
+    decay_wheel_.Advance(current_tick, decay_due_);
+    for (const auto& entry : decay_due_) {
+        // Timers of removed heroes, or superseded by a newer accomplishment, are stale
+        u32 row = heroes_.Find(entry.item);
+        if (row == INVALID_HERO_ROW || heroes_.GetDecayDueTick(row) != entry.tick) {
+            continue;
+        }
+
+        // Heroes in formula-LOD regions are not decayed here: the timer is
+        // only re-armed a year out, and the owed decay is caught up when the
+        // hero is next accessed (award, move, GetHero) or leaves formula LOD
+        RegionID region = heroes_.GetRegion(row);
+        if (lod_system_ && region != INVALID_REGION_ID &&
+            lod_system_->GetRegionLOD(region) == SimulationLOD::Formula) {
+            Tick ticks_per_year = Config::Configuration::GetInstance().world.ticks_per_year;
+            heroes_.SetDecayDueTick(row, current_tick + ticks_per_year);
+            decay_wheel_.Schedule(entry.item, current_tick + ticks_per_year);
+            continue;
+        }
+
+        row = CatchUpDecay(row);
+        if (row != INVALID_HERO_ROW) {
+            ScheduleDecay(row);
+        }
+    }
+}
+
+u16 HeroSystem::GetDecayOwed(u32 row, Tick tick) const {
+    if (decay_ticks_per_point_ <= 0.0) {
+        return heroes_.GetDecayApplied(row);
+    }
+
+    // First point is lost when the hero becomes eligible, then one point
+    // every decay_ticks_per_point_ ticks
+    Tick start = heroes_.GetLastAccomplishmentTick(row) + decay_delay_ticks_;
+    if (tick < start) {
+        return heroes_.GetDecayApplied(row);
+    }
+    f64 owed = 1.0 + std::floor(static_cast<f64>(tick - start) / decay_ticks_per_point_);
+    u32 base_renown = static_cast<u32>(heroes_.GetRenown(row)) + heroes_.GetDecayApplied(row);
+    return static_cast<u16>(std::max<f64>(heroes_.GetDecayApplied(row), std::min<f64>(owed, base_renown)));
+}
+
+u32 HeroSystem::CatchUpDecay(u32 row) {
+    u16 owed = GetDecayOwed(row, current_tick_);
+    u16 applied = heroes_.GetDecayApplied(row);
+    if (owed == applied) {
+        return row;
+    }
+
+    u16 renown = heroes_.GetRenown(row);
+    u16 new_renown = static_cast<u16>(renown - std::min<u16>(static_cast<u16>(owed - applied), renown));
+    heroes_.SetDecayApplied(row, owed);
+    if (new_renown < config_.renown.min_renown) {
+        RemoveHero(heroes_.GetEntity(row));
+        return INVALID_HERO_ROW;
+    }
+    return SetRenown(row, new_renown);
+}
+
+void HeroSystem::ScheduleDecay(u32 row) {
+    if (decay_ticks_per_point_ <= 0.0) {
+        return;
+    }
+
+    // Next tick at which the owed decay exceeds what has been applied
+    Tick start = heroes_.GetLastAccomplishmentTick(row) + decay_delay_ticks_;
+    f64 offset = std::ceil(static_cast<f64>(heroes_.GetDecayApplied(row)) * decay_ticks_per_point_);
+    Tick due = std::max(start + static_cast<Tick>(offset), current_tick_ + 1);
+    heroes_.SetDecayDueTick(row, due);
+    decay_wheel_.Schedule(heroes_.GetEntity(row), due);
+}
+
+u32 HeroSystem::SetRenown(u32 row, u16 renown) {
+    heroes_.SetRenown(row, renown);
+    MarkInfluenceDirty(row);
+    return heroes_.SetTier(row, Components::GetTierForRenown(renown, config_.renown));
+}
+
+void HeroSystem::MarkInfluenceDirty(u32 row) {
+    if (!heroes_.IsInfluenceDirty(row)) {
+        heroes_.SetInfluenceDirty(row, true);
+        dirty_heroes_.push_back(heroes_.GetEntity(row));
+    }
+}
+
+u8 HeroSystem::DetermineHeroType(const Components::Skills& skills) const {
+    // TODO: Classify by dominant skill category
+    (void)skills;
+    return 4;  // Mixed
+}
+
+u8 HeroSystem::GetTierRadius(Components::HeroTier tier) const {
+    switch (tier) {
+        case Components::HeroTier::Local:
+            return config_.influence.local_hero_radius;
+        case Components::HeroTier::Regional:
+            return config_.influence.regional_hero_radius;
+        case Components::HeroTier::National:
+            return config_.influence.national_hero_radius;
+        case Components::HeroTier::Legendary:
+            return config_.influence.legendary_hero_radius;
+        default:
+            return 0;
+    }
+}
+
+} // namespace Heroes
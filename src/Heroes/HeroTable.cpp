@@ -0,0 +1,154 @@
+#include "Heroes/HeroTable.h"
+#include <algorithm>
+#include <utility>
+
+namespace Heroes {
+
+HeroTable::HeroTable() = default;
+
+HeroTable::~HeroTable() = default;
+
+void HeroTable::Clear() {
+    entities_.clear();
+    tiers_.clear();
+    renown_.clear();
+    hero_types_.clear();
+    regions_.clear();
+    last_accomplishment_ticks_.clear();
+    promotion_ticks_.clear();
+    applied_regions_.clear();
+    applied_renown_.clear();
+    influence_dirty_.clear();
+    decay_applied_.clear();
+    decay_due_ticks_.clear();
+    tier_begin_.fill(0);
+    sorted_entities_.clear();
+    sorted_rows_.clear();
+}
+
+u32 HeroTable::Find(EntityID entity) const {
+    auto it = std::lower_bound(sorted_entities_.begin(), sorted_entities_.end(), entity);
+    if (it == sorted_entities_.end() || *it != entity) {
+        return INVALID_HERO_ROW;
+    }
+    return sorted_rows_[it - sorted_entities_.begin()];
+}
+
+u32 HeroTable::Insert(EntityID entity, Components::HeroTier tier) {
+    auto it = std::lower_bound(sorted_entities_.begin(), sorted_entities_.end(), entity);
+    if (it != sorted_entities_.end() && *it == entity) {
+        return SetTier(sorted_rows_[it - sorted_entities_.begin()], tier);
+    }
+
+    // Append to the last tier, then hop down one partition boundary per tier
+    u32 row = GetCount();
+    sorted_rows_.insert(sorted_rows_.begin() + (it - sorted_entities_.begin()), row);
+    sorted_entities_.insert(it, entity);
+
+    entities_.push_back(entity);
+    tiers_.push_back(tier);
+    renown_.push_back(0);
+    hero_types_.push_back(0);
+    regions_.push_back(INVALID_REGION_ID);
+    last_accomplishment_ticks_.push_back(0);
+    promotion_ticks_.push_back(0);
+    applied_regions_.push_back(INVALID_REGION_ID);
+    applied_renown_.push_back(0);
+    influence_dirty_.push_back(0);
+    decay_applied_.push_back(0);
+    decay_due_ticks_.push_back(0);
+    ++tier_begin_[Components::HERO_TIER_COUNT];
+
+    for (u8 t = Components::HERO_TIER_COUNT - 1; t > static_cast<u8>(tier); --t) {
+        u32 first = tier_begin_[t];
+        SwapRows(row, first);
+        row = first;
+        ++tier_begin_[t];
+    }
+    return row;
+}
+
+void HeroTable::Remove(u32 row) {
+    // Carry the row to the end through each later tier, filling each gap with
+    // that tier's last row
+    for (u8 t = static_cast<u8>(tiers_[row]); t < Components::HERO_TIER_COUNT; ++t) {
+        u32 last = tier_begin_[t + 1] - 1;
+        SwapRows(row, last);
+        row = last;
+        --tier_begin_[t + 1];
+    }
+
+    auto it = std::lower_bound(sorted_entities_.begin(), sorted_entities_.end(), entities_[row]);
+    sorted_rows_.erase(sorted_rows_.begin() + (it - sorted_entities_.begin()));
+    sorted_entities_.erase(it);
+
+    entities_.pop_back();
+    tiers_.pop_back();
+    renown_.pop_back();
+    hero_types_.pop_back();
+    regions_.pop_back();
+    last_accomplishment_ticks_.pop_back();
+    promotion_ticks_.pop_back();
+    applied_regions_.pop_back();
+    applied_renown_.pop_back();
+    influence_dirty_.pop_back();
+    decay_applied_.pop_back();
+    decay_due_ticks_.pop_back();
+}
+
+u32 HeroTable::SetTier(u32 row, Components::HeroTier tier) {
+    u8 t = static_cast<u8>(tiers_[row]);
+    u8 target = static_cast<u8>(tier);
+    while (t < target) {
+        u32 last = tier_begin_[t + 1] - 1;
+        SwapRows(row, last);
+        row = last;
+        --tier_begin_[t + 1];
+        ++t;
+    }
+    while (t > target) {
+        u32 first = tier_begin_[t];
+        SwapRows(row, first);
+        row = first;
+        ++tier_begin_[t];
+        --t;
+    }
+    tiers_[row] = tier;
+    return row;
+}
+
+std::span<const EntityID> HeroTable::GetEntities(Components::HeroTier tier) const {
+    u32 begin = GetTierBegin(tier);
+    return std::span<const EntityID>(entities_).subspan(begin, GetTierEnd(tier) - begin);
+}
+
+void HeroTable::SetApplied(u32 row, RegionID region_id, u16 renown) {
+    applied_regions_[row] = region_id;
+    applied_renown_[row] = renown;
+}
+
+u32& HeroTable::LookupRow(EntityID entity) {
+    auto it = std::lower_bound(sorted_entities_.begin(), sorted_entities_.end(), entity);
+    return sorted_rows_[it - sorted_entities_.begin()];
+}
+
+void HeroTable::SwapRows(u32 a, u32 b) {
+    if (a == b) {
+        return;
+    }
+    std::swap(LookupRow(entities_[a]), LookupRow(entities_[b]));
+    std::swap(entities_[a], entities_[b]);
+    std::swap(tiers_[a], tiers_[b]);
+    std::swap(renown_[a], renown_[b]);
+    std::swap(hero_types_[a], hero_types_[b]);
+    std::swap(regions_[a], regions_[b]);
+    std::swap(last_accomplishment_ticks_[a], last_accomplishment_ticks_[b]);
+    std::swap(promotion_ticks_[a], promotion_ticks_[b]);
+    std::swap(applied_regions_[a], applied_regions_[b]);
+    std::swap(applied_renown_[a], applied_renown_[b]);
+    std::swap(influence_dirty_[a], influence_dirty_[b]);
+    std::swap(decay_applied_[a], decay_applied_[b]);
+    std::swap(decay_due_ticks_[a], decay_due_ticks_[b]);
+}
+
+} // namespace Heroes
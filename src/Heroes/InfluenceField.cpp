@@ -0,0 +1,165 @@
+#include "Heroes/InfluenceField.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Heroes {
+
+InfluenceField::InfluenceField() = default;
+
+InfluenceField::~InfluenceField() = default;
+
+void InfluenceField::Resize(u16 grid_width, u16 grid_height) {
+    grid_width_ = grid_width;
+    grid_height_ = grid_height;
+    values_.assign(static_cast<size_t>(grid_width) * static_cast<size_t>(grid_height), 0.0f);
+}
+
+void InfluenceField::Clear() {
+    std::fill(values_.begin(), values_.end(), 0.0f);
+}
+
+void InfluenceField::AccumulateTier(std::span<const InfluenceSource> sources, u8 radius,
+                                    f32 base_divisor, f32 distance_exponent) {
+    if (sources.empty() || values_.empty() || base_divisor <= 0.0f) {
+        return;
+    }
+
+    // Falloff per distance: K(d) for d = 0..R, K(R + 1) = 0
+    const i32 r = radius;
+    falloff_.assign(static_cast<size_t>(r) + 2, 0.0f);
+    for (i32 k = 0; k <= r; ++k) {
+        f32 distance_modifier = 1.0f / (1.0f + std::pow(static_cast<f32>(k), distance_exponent));
+        falloff_[k] = distance_modifier / base_divisor;
+    }
+
+    // Only the sources' bounding box grown by the radius can receive influence
+    i32 min_x = grid_width_, min_y = grid_height_, max_x = -1, max_y = -1;
+    size_t valid_sources = 0;
+    for (const auto& source : sources) {
+        if (source.region_id >= values_.size()) {
+            continue;
+        }
+        i32 sx = static_cast<i32>(source.region_id % grid_width_);
+        i32 sy = static_cast<i32>(source.region_id / grid_width_);
+        min_x = std::min(min_x, sx);
+        min_y = std::min(min_y, sy);
+        max_x = std::max(max_x, sx);
+        max_y = std::max(max_y, sy);
+        ++valid_sources;
+    }
+    if (valid_sources == 0) {
+        return;
+    }
+
+    const i32 x0 = std::max(0, min_x - r);
+    const i32 y0 = std::max(0, min_y - r);
+    const i32 x1 = std::min(static_cast<i32>(grid_width_) - 1, max_x + r);
+    const i32 y1 = std::min(static_cast<i32>(grid_height_) - 1, max_y + r);
+
+    // A few scattered sources (typically incremental updates) are cheaper to
+    // stamp directly than to sweep their whole bounding box once per ring
+    u64 stamp_cost = static_cast<u64>(valid_sources) * static_cast<u64>(2 * r + 1) * static_cast<u64>(2 * r + 1);
+    u64 sweep_cost = static_cast<u64>(x1 - x0 + 1) * static_cast<u64>(y1 - y0 + 1) * static_cast<u64>(r + 2);
+    if (stamp_cost <= sweep_cost) {
+        for (const auto& source : sources) {
+            if (source.region_id < values_.size()) {
+                StampSource(source, r);
+            }
+        }
+    } else {
+        SweepSummedArea(sources, r, x0, y0, x1, y1);
+    }
+}
+
+void InfluenceField::StampSource(const InfluenceSource& source, i32 radius) {
+    const i32 sx = static_cast<i32>(source.region_id % grid_width_);
+    const i32 sy = static_cast<i32>(source.region_id / grid_width_);
+    const i32 y_begin = std::max(0, sy - radius);
+    const i32 y_end = std::min(static_cast<i32>(grid_height_) - 1, sy + radius);
+    const i32 x_begin = std::max(0, sx - radius);
+    const i32 x_end = std::min(static_cast<i32>(grid_width_) - 1, sx + radius);
+
+    for (i32 y = y_begin; y <= y_end; ++y) {
+        f32* row = values_.data() + static_cast<size_t>(y) * grid_width_;
+        const i32 dy = std::abs(y - sy);
+        for (i32 x = x_begin; x <= x_end; ++x) {
+            const i32 distance = std::max(dy, std::abs(x - sx));
+            row[x] += source.weight * falloff_[distance];
+        }
+    }
+}
+
+void InfluenceField::SweepSummedArea(std::span<const InfluenceSource> sources, i32 radius,
+                                     i32 x0, i32 y0, i32 x1, i32 y1) {
+    const i32 r = radius;
+    const i32 box_w = x1 - x0 + 1;
+    const i32 box_h = y1 - y0 + 1;
+    const size_t stride = static_cast<size_t>(box_w) + 1;
+
+    // Summed-area table of source weight over the box (row/column 0 are padding)
+    summed_area_.assign(stride * (static_cast<size_t>(box_h) + 1), 0.0);
+    for (const auto& source : sources) {
+        if (source.region_id >= values_.size()) {
+            continue;
+        }
+        i32 lx = static_cast<i32>(source.region_id % grid_width_) - x0;
+        i32 ly = static_cast<i32>(source.region_id / grid_width_) - y0;
+        summed_area_[(static_cast<size_t>(ly) + 1) * stride + static_cast<size_t>(lx) + 1] += source.weight;
+    }
+    for (i32 y = 1; y <= box_h; ++y) {
+        f64* row = summed_area_.data() + static_cast<size_t>(y) * stride;
+        const f64* above = row - stride;
+        f64 running = 0.0;
+        for (i32 x = 1; x <= box_w; ++x) {
+            running += row[x];
+            row[x] = above[x] + running;
+        }
+    }
+
+    for (i32 k = 0; k <= r; ++k) {
+        // Ring weight c_k = K(k) - K(k + 1)
+        const f64 ring_weight = static_cast<f64>(falloff_[k]) - static_cast<f64>(falloff_[k + 1]);
+        if (ring_weight == 0.0) {
+            continue;
+        }
+        // Columns whose window is not clipped by the box edge
+        const i32 inner_begin = std::min(k, box_w);
+        const i32 inner_end = std::max(inner_begin, box_w - k);
+
+        for (i32 ly = 0; ly < box_h; ++ly) {
+            const i32 top_row = std::max(0, ly - k);
+            const i32 bottom_row = std::min(box_h - 1, ly + k) + 1;
+            const f64* top = summed_area_.data() + static_cast<size_t>(top_row) * stride;
+            const f64* bottom = summed_area_.data() + static_cast<size_t>(bottom_row) * stride;
+            f32* out = values_.data() + static_cast<size_t>(y0 + ly) * grid_width_ + static_cast<size_t>(x0);
+
+            auto clipped = [&](i32 lx) {
+                i32 left = std::max(0, lx - k);
+                i32 right = std::min(box_w - 1, lx + k) + 1;
+                f64 box = bottom[right] - bottom[left] - top[right] + top[left];
+                out[lx] += static_cast<f32>(ring_weight * box);
+            };
+
+            for (i32 lx = 0; lx < inner_begin; ++lx) {
+                clipped(lx);
+            }
+            // Interior: fixed offsets, contiguous loads, no branches
+            for (i32 lx = inner_begin; lx < inner_end; ++lx) {
+                f64 box = bottom[lx + k + 1] - bottom[lx - k] - top[lx + k + 1] + top[lx - k];
+                out[lx] += static_cast<f32>(ring_weight * box);
+            }
+            for (i32 lx = inner_end; lx < box_w; ++lx) {
+                clipped(lx);
+            }
+        }
+    }
+}
+
+f32 InfluenceField::GetInfluence(RegionID region_id) const {
+    if (region_id >= values_.size()) {
+        return 0.0f;
+    }
+    return values_[region_id];
+}
+
+} // namespace Heroes
@@ -551,31 +551,11 @@ std::vector<RegionID> WorldScene::GetNeighborRegions(RegionID region_id, u8 rang
         return neighbors;
     }
     
-    // Get grid position of selected region
-    u16 center_x, center_y;
-    GetRegionGridPosition(region_id, center_x, center_y);
-    
-    // Get all regions within range (including diagonals)
-    for (i16 dy = -static_cast<i16>(range); dy <= static_cast<i16>(range); ++dy) {
-        for (i16 dx = -static_cast<i16>(range); dx <= static_cast<i16>(range); ++dx) {
-            // Skip center (selected region itself)
-            if (dx == 0 && dy == 0) {
-                continue;
-            }
-            
-            u16 grid_x = static_cast<u16>(static_cast<i16>(center_x) + dx);
-            u16 grid_y = static_cast<u16>(static_cast<i16>(center_y) + dy);
-            
-            // Check bounds
-            if (grid_x >= grid_width_ || grid_y >= grid_height_) {
-                continue;
-            }
-            
-            RegionID neighbor_id = GetRegionAtGridPosition(grid_x, grid_y);
-            if (neighbor_id != INVALID_REGION_ID) {
-                neighbors.push_back(neighbor_id);
-            }
-        }
+    // Breadth-first expansion over the world's adjacency (8-neighbourhood, so
+    // 'range' steps cover the same square window as a dx/dy scan)
+    const Simulation::World* world = simulation_manager_->GetWorld();
+    if (world) {
+        world->GetRegionsInRange(region_id, range, neighbors);
     }
     
     return neighbors;
@@ -231,8 +231,13 @@ void WorldSidebarScene::RenderRegionStats(Platform::IVideo* video, const Simulat
     y_pos += line_height + 10;
     
     // Neighbors
-    const auto& neighbors = region->GetNeighbors();
-    video->DrawText("Neighbors: " + std::to_string(neighbors.size()), 10, y_pos, 200, 200, 200, 255);
+    size_t neighbor_count = 0;
+    const Simulation::World* world = WorldSceneSharedState::g_simulation_manager ?
+        WorldSceneSharedState::g_simulation_manager->GetWorld() : nullptr;
+    if (world) {
+        neighbor_count = world->GetNeighbors(region->GetID()).size();
+    }
+    video->DrawText("Neighbors: " + std::to_string(neighbor_count), 10, y_pos, 200, 200, 200, 255);
 }
 
 } // namespace Game
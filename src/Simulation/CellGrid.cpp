@@ -0,0 +1,81 @@
+#include "Simulation/CellGrid.h"
+
+namespace Simulation {
+
+CellGrid::TypeID CellGrid::InternType(const std::string& type) {
+    auto it = type_ids_.find(type);
+    if (it != type_ids_.end()) {
+        return it->second;
+    }
+    if (type_names_.size() >= INVALID_TYPE) {
+        return INVALID_TYPE;
+    }
+    TypeID id = static_cast<TypeID>(type_names_.size());
+    type_names_.push_back(type);
+    type_ids_.emplace(type, id);
+    return id;
+}
+
+CellGrid::TypeID CellGrid::FindType(const std::string& type) const {
+    auto it = type_ids_.find(type);
+    return it != type_ids_.end() ? it->second : INVALID_TYPE;
+}
+
+void CellGrid::ClearTypes() {
+    type_names_.clear();
+    type_ids_.clear();
+}
+
+void CellGrid::Reset(u16 width, u16 height, TypeID type) {
+    width_ = width;
+    height_ = height;
+    size_t cell_count = static_cast<size_t>(width) * height;
+    types_.assign(cell_count, type);
+    source_flags_.assign(cell_count, 0);
+    source_parents_.assign(cell_count, INVALID_REGION_ID);
+    names_.clear();
+    changes_.clear();
+}
+
+void CellGrid::Assign(u16 width, u16 height, std::span<const TypeID> types,
+                      std::span<const RegionID> source_parents) {
+    width_ = width;
+    height_ = height;
+    types_.assign(types.begin(), types.end());
+    source_parents_.assign(source_parents.begin(), source_parents.end());
+    source_flags_.assign(types_.size(), 0);
+    names_.clear();
+    changes_.clear();
+}
+
+const std::string& CellGrid::GetName(u32 cell) const {
+    static const std::string empty_name;
+    auto it = names_.find(cell);
+    return it != names_.end() ? it->second : empty_name;
+}
+
+void CellGrid::SetCell(u32 cell, TypeID type, RegionID source_parent) {
+    if (types_[cell] != type) {
+        changes_.push_back(cell);
+        ++change_count_;
+    }
+    types_[cell] = type;
+    source_parents_[cell] = source_parent;
+    if (source_flags_[cell]) {
+        source_flags_[cell] = 0;
+        names_.erase(cell);
+    }
+}
+
+void CellGrid::SetSource(u32 cell, TypeID type, const std::string& name) {
+    if (types_[cell] != type) {
+        changes_.push_back(cell);
+        ++change_count_;
+    }
+    types_[cell] = type;
+    source_flags_[cell] = 1;
+    source_parents_[cell] = INVALID_REGION_ID;
+    names_[cell] = name;
+}
+
+} // namespace Simulation
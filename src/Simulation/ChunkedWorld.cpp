@@ -0,0 +1,186 @@
+#include "Simulation/ChunkedWorld.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace Simulation {
+
+namespace {
+constexpr u32 SPILL_MAGIC = 0x4B4E4843;  // "CHNK"
+}
+
+ChunkedWorld::ChunkedWorld(std::unique_ptr<World> world, CellGrid cells, u16 chunk_size)
+    : world_(std::move(world)), cells_(std::move(cells)), chunk_size_(chunk_size > 0 ? chunk_size : 1) {
+    chunks_x_ = static_cast<u16>((static_cast<u32>(world_->GetGridWidth()) + chunk_size_ - 1) / chunk_size_);
+    chunks_y_ = static_cast<u16>((static_cast<u32>(world_->GetGridHeight()) + chunk_size_ - 1) / chunk_size_);
+    size_t chunk_count = static_cast<size_t>(chunks_x_) * chunks_y_;
+    chunks_.resize(chunk_count);
+    spilled_.assign(chunk_count, 0);
+    resident_positions_.resize(chunk_count, resident_order_.end());
+}
+
+ChunkedWorld::~ChunkedWorld() {
+    if (spill_directory_.empty()) {
+        return;
+    }
+    for (u32 i = 0; i < spilled_.size(); ++i) {
+        if (spilled_[i]) {
+            std::error_code error;
+            std::filesystem::remove(GetSpillPath(i), error);
+        }
+    }
+}
+
+bool ChunkedWorld::SetSpillDirectory(const std::string& directory) {
+    if (std::find(spilled_.begin(), spilled_.end(), 1) != spilled_.end()) {
+        LOG_ERROR("ChunkedWorld: ERROR - Spill directory cannot change once chunks are spilled");
+        return false;
+    }
+    if (!directory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error) {
+            LOG_ERROR("ChunkedWorld: ERROR - Cannot create spill directory " << directory
+                   << ": " << error.message());
+            return false;
+        }
+    }
+    spill_directory_ = directory;
+    return true;
+}
+
+ChunkedWorld::Chunk* ChunkedWorld::AcquireChunk(u16 chunk_x, u16 chunk_y) {
+    if (chunk_x >= chunks_x_ || chunk_y >= chunks_y_) {
+        return nullptr;
+    }
+    u32 index = static_cast<u32>(chunk_y) * chunks_x_ + chunk_x;
+
+    if (chunks_[index]) {
+        resident_order_.splice(resident_order_.begin(), resident_order_, resident_positions_[index]);
+        return chunks_[index].get();
+    }
+
+    auto chunk = std::make_unique<Chunk>();
+    chunk->chunk_x = chunk_x;
+    chunk->chunk_y = chunk_y;
+    chunk->origin_x = static_cast<u16>(chunk_x * chunk_size_);
+    chunk->origin_y = static_cast<u16>(chunk_y * chunk_size_);
+    chunk->width = static_cast<u16>(std::min<u32>(chunk_size_, GetGridWidth() - chunk->origin_x));
+    chunk->height = static_cast<u16>(std::min<u32>(chunk_size_, GetGridHeight() - chunk->origin_y));
+    Materialize(*chunk);
+    if (spilled_[index] && !Restore(*chunk, index)) {
+        LOG_WARNING("ChunkedWorld: WARNING - Could not restore chunk (" << chunk_x << ", " << chunk_y
+                 << "), regenerated from the grid");
+    }
+
+    chunks_[index] = std::move(chunk);
+    resident_order_.push_front(index);
+    resident_positions_[index] = resident_order_.begin();
+    EvictOverLimit(index);
+    return chunks_[index].get();
+}
+
+Region* ChunkedWorld::GetRegion(RegionID region_id) {
+    if (region_id >= cells_.GetCellCount()) {
+        return nullptr;
+    }
+    return GetRegionAtGrid(cells_.GetCellX(region_id), cells_.GetCellY(region_id));
+}
+
+Region* ChunkedWorld::GetRegionAtGrid(u16 grid_x, u16 grid_y) {
+    if (grid_x >= GetGridWidth() || grid_y >= GetGridHeight()) {
+        return nullptr;
+    }
+    Chunk* chunk = AcquireChunk(grid_x / chunk_size_, grid_y / chunk_size_);
+    return &chunk->GetRegionAtGrid(grid_x, grid_y);
+}
+
+void ChunkedWorld::EvictAll() {
+    if (spill_directory_.empty()) {
+        return;
+    }
+    while (!resident_order_.empty()) {
+        if (!Spill(resident_order_.back())) {
+            return;
+        }
+    }
+}
+
+void ChunkedWorld::Materialize(Chunk& chunk) const {
+    f32 region_size = GetRegionSize();
+    chunk.regions.clear();
+    chunk.regions.reserve(static_cast<size_t>(chunk.width) * chunk.height);
+
+    for (u16 y = chunk.origin_y; y < chunk.origin_y + chunk.height; ++y) {
+        for (u16 x = chunk.origin_x; x < chunk.origin_x + chunk.width; ++x) {
+            u32 cell = cells_.GetCell(x, y);
+            Region& region = chunk.regions.emplace_back(cell, cells_.GetTypeName(cells_.GetTypeAt(cell)));
+            region.SetPosition(static_cast<f32>(x) * region_size, static_cast<f32>(y) * region_size);
+            if (cells_.IsSource(cell)) {
+                region.SetIsSource(true);
+                region.SetName(cells_.GetName(cell));
+            }
+            region.SetSourceParentID(cells_.GetSourceParent(cell));
+            region.Initialize();
+        }
+    }
+}
+
+bool ChunkedWorld::Spill(u32 chunk_index) {
+    Chunk& chunk = *chunks_[chunk_index];
+    std::ofstream file(GetSpillPath(chunk_index), std::ios::binary | std::ios::trunc);
+    u32 region_count = static_cast<u32>(chunk.regions.size());
+    file.write(reinterpret_cast<const char*>(&SPILL_MAGIC), sizeof(SPILL_MAGIC));
+    file.write(reinterpret_cast<const char*>(&region_count), sizeof(region_count));
+    for (const Region& region : chunk.regions) {
+        region.WriteState(file);
+    }
+    file.close();
+    if (!file) {
+        LOG_ERROR("ChunkedWorld: ERROR - Failed to spill chunk (" << chunk.chunk_x << ", "
+               << chunk.chunk_y << ") to " << spill_directory_);
+        return false;
+    }
+
+    spilled_[chunk_index] = 1;
+    resident_order_.erase(resident_positions_[chunk_index]);
+    resident_positions_[chunk_index] = resident_order_.end();
+    chunks_[chunk_index].reset();
+    return true;
+}
+
+bool ChunkedWorld::Restore(Chunk& chunk, u32 chunk_index) const {
+    std::ifstream file(GetSpillPath(chunk_index), std::ios::binary);
+    u32 magic = 0;
+    u32 region_count = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char*>(&region_count), sizeof(region_count));
+    if (!file || magic != SPILL_MAGIC || region_count != chunk.regions.size()) {
+        return false;
+    }
+    for (Region& region : chunk.regions) {
+        if (!region.ReadState(file)) {
+            Materialize(chunk);
+            return false;
+        }
+    }
+    return true;
+}
+
+void ChunkedWorld::EvictOverLimit(u32 keep_index) {
+    if (spill_directory_.empty() || resident_limit_ == 0) {
+        return;
+    }
+    while (resident_order_.size() > resident_limit_ && resident_order_.back() != keep_index) {
+        if (!Spill(resident_order_.back())) {
+            return;
+        }
+    }
+}
+
+std::string ChunkedWorld::GetSpillPath(u32 chunk_index) const {
+    return (std::filesystem::path(spill_directory_) / ("chunk_" + std::to_string(chunk_index) + ".bin")).string();
+}
+
+} // namespace Simulation
@@ -0,0 +1,127 @@
+#include "Simulation/FeatureIndex.h"
+#include <limits>
+
+namespace Simulation {
+
+namespace {
+constexpr u64 NO_DISTANCE = std::numeric_limits<u64>::max();
+}
+
+void FeatureIndex::Build(u16 width, u16 height, std::span<const u8> sites) {
+    width_ = width;
+    height_ = height;
+    has_sites_ = false;
+    size_t cell_count = static_cast<size_t>(width) * height;
+    nearest_.assign(cell_count, NO_SITE);
+    if (cell_count == 0 || sites.size() < cell_count) {
+        return;
+    }
+
+    // Column pass, row-major: nearest site at or above each cell, then
+    // replaced by the nearest site below where that is closer
+    for (u32 y = 0; y < height; ++y) {
+        u32 row = y * width;
+        for (u32 x = 0; x < width; ++x) {
+            u32 cell = row + x;
+            if (sites[cell]) {
+                nearest_[cell] = cell;
+                has_sites_ = true;
+            } else if (y > 0) {
+                nearest_[cell] = nearest_[cell - width];
+            }
+        }
+    }
+    if (!has_sites_) {
+        return;
+    }
+
+    row_sites_.assign(width, NO_SITE);  // Nearest site at or below, per column
+    for (u32 y = height; y-- > 0;) {
+        u32 row = y * width;
+        for (u32 x = 0; x < width; ++x) {
+            u32 cell = row + x;
+            if (sites[cell]) {
+                row_sites_[x] = cell;
+                continue;
+            }
+            u32 below = row_sites_[x];
+            if (below == NO_SITE) {
+                continue;
+            }
+            u32 above = nearest_[cell];
+            if (above == NO_SITE || below / width - y < y - above / width) {
+                nearest_[cell] = below;
+            }
+        }
+    }
+
+    // Row pass: lower envelope of parabolas (x - q)^2 + column_distance(q)^2
+    row_costs_.resize(width);
+    row_sites_.resize(width);
+    hull_columns_.resize(width);
+    hull_starts_.resize(static_cast<size_t>(width) + 1);
+    for (u32 y = 0; y < height; ++y) {
+        u32 row = y * width;
+        for (u32 x = 0; x < width; ++x) {
+            u32 site = nearest_[row + x];
+            row_sites_[x] = site;
+            if (site == NO_SITE) {
+                row_costs_[x] = NO_DISTANCE;
+            } else {
+                u64 dy = static_cast<u64>(site / width > y ? site / width - y : y - site / width);
+                row_costs_[x] = dy * dy;
+            }
+        }
+
+        u32 hull_size = 0;
+        for (u32 q = 0; q < width; ++q) {
+            if (row_costs_[q] == NO_DISTANCE) {
+                continue;
+            }
+            f64 q_term = static_cast<f64>(row_costs_[q]) + static_cast<f64>(q) * q;
+            f64 start = -std::numeric_limits<f64>::infinity();
+            while (hull_size > 0) {
+                u32 v = hull_columns_[hull_size - 1];
+                f64 v_term = static_cast<f64>(row_costs_[v]) + static_cast<f64>(v) * v;
+                start = (q_term - v_term) / (2.0 * (static_cast<f64>(q) - static_cast<f64>(v)));
+                if (start > hull_starts_[hull_size - 1]) {
+                    break;
+                }
+                --hull_size;
+                start = -std::numeric_limits<f64>::infinity();
+            }
+            hull_columns_[hull_size] = static_cast<u16>(q);
+            hull_starts_[hull_size] = start;
+            ++hull_size;
+        }
+        hull_starts_[hull_size] = std::numeric_limits<f64>::infinity();
+
+        u32 segment = 0;
+        for (u32 x = 0; x < width; ++x) {
+            while (hull_starts_[segment + 1] < static_cast<f64>(x)) {
+                ++segment;
+            }
+            nearest_[row + x] = row_sites_[hull_columns_[segment]];
+        }
+    }
+}
+
+std::pair<u16, u16> FeatureIndex::GetNearestPosition(u16 x, u16 y) const {
+    u32 site = GetNearestSite(x, y);
+    if (site == NO_SITE) {
+        return {0xFFFF, 0xFFFF};
+    }
+    return {static_cast<u16>(site % width_), static_cast<u16>(site / width_)};
+}
+
+u64 FeatureIndex::GetSquaredDistance(u16 x, u16 y) const {
+    u32 site = GetNearestSite(x, y);
+    if (site == NO_SITE) {
+        return NO_DISTANCE;
+    }
+    i64 dx = static_cast<i64>(site % width_) - x;
+    i64 dy = static_cast<i64>(site / width_) - y;
+    return static_cast<u64>(dx * dx + dy * dy);
+}
+
+} // namespace Simulation
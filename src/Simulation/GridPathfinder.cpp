@@ -0,0 +1,156 @@
+#include "Simulation/GridPathfinder.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace Simulation {
+
+void GridPathfinder::Resize(u16 width, u16 height) {
+    width_ = width;
+    height_ = height;
+    size_t cell_count = static_cast<size_t>(width) * height;
+    classes_.assign(cell_count, 0);
+    g_costs_.assign(cell_count, 0);
+    parents_.assign(cell_count, INVALID_CELL);
+    seen_.assign(cell_count, 0);
+    closed_.assign(cell_count, 0);
+    generation_ = 0;
+}
+
+bool GridPathfinder::FindPath(std::pair<u16, u16> start, std::pair<u16, u16> end,
+                              std::vector<std::pair<u16, u16>>& path) {
+    u32 source = GetCell(start.first, start.second);
+    return Search(std::span<const u32>(&source, 1), GetCell(end.first, end.second), path);
+}
+
+bool GridPathfinder::FindPath(std::span<const std::pair<u16, u16>> starts, std::pair<u16, u16> end,
+                              std::vector<std::pair<u16, u16>>& path) {
+    sources_.clear();
+    for (const auto& start : starts) {
+        sources_.push_back(GetCell(start.first, start.second));
+    }
+    return Search(sources_, GetCell(end.first, end.second), path);
+}
+
+void GridPathfinder::NextGeneration() {
+    if (++generation_ == 0) {
+        std::fill(seen_.begin(), seen_.end(), 0);
+        std::fill(closed_.begin(), closed_.end(), 0);
+        generation_ = 1;
+    }
+}
+
+bool GridPathfinder::Search(std::span<const u32> sources, u32 target, std::vector<std::pair<u16, u16>>& path) {
+    path.clear();
+    NextGeneration();
+    heap_.clear();
+    expanded_count_ = 0;
+
+    const i32 target_x = static_cast<i32>(target % width_);
+    const i32 target_y = static_cast<i32>(target / width_);
+    // Manhattan distance (every enterable cell costs at least 1)
+    auto heuristic = [&](u32 cell) -> u32 {
+        return static_cast<u32>(std::abs(static_cast<i32>(cell % width_) - target_x) +
+                                std::abs(static_cast<i32>(cell / width_) - target_y));
+    };
+
+    for (u32 source : sources) {
+        seen_[source] = generation_;
+        g_costs_[source] = 0;
+        parents_[source] = INVALID_CELL;
+        u32 h_cost = heuristic(source);
+        PushHeap({h_cost, h_cost, source});
+    }
+
+    while (!heap_.empty()) {
+        u32 cell = PopHeap().cell;
+        if (closed_[cell] == generation_) {
+            continue;
+        }
+        closed_[cell] = generation_;
+        ++expanded_count_;
+
+        if (cell == target) {
+            for (u32 step = cell; parents_[step] != INVALID_CELL; step = parents_[step]) {
+                path.push_back({static_cast<u16>(step % width_), static_cast<u16>(step / width_)});
+            }
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+
+        u16 x = static_cast<u16>(cell % width_);
+        u16 y = static_cast<u16>(cell / width_);
+        u32 neighbors[4];
+        u32 neighbor_count = 0;
+        if (y > 0) neighbors[neighbor_count++] = cell - width_;
+        if (x + 1 < width_) neighbors[neighbor_count++] = cell + 1;
+        if (y + 1 < height_) neighbors[neighbor_count++] = cell + width_;
+        if (x > 0) neighbors[neighbor_count++] = cell - 1;
+
+        u32 g_cost = g_costs_[cell];
+        for (u32 i = 0; i < neighbor_count; ++i) {
+            u32 neighbor = neighbors[i];
+            u16 cost = class_costs_[classes_[neighbor]];
+            if (cost == BLOCKED || closed_[neighbor] == generation_) {
+                continue;
+            }
+            u32 new_g_cost = g_cost + cost;
+            if (seen_[neighbor] != generation_ || new_g_cost < g_costs_[neighbor]) {
+                seen_[neighbor] = generation_;
+                g_costs_[neighbor] = new_g_cost;
+                parents_[neighbor] = cell;
+                u32 h_cost = heuristic(neighbor);
+                PushHeap({new_g_cost + h_cost, h_cost, neighbor});
+            }
+        }
+    }
+
+    return false;
+}
+
+void GridPathfinder::PushHeap(HeapEntry entry) {
+    size_t index = heap_.size();
+    heap_.push_back(entry);
+    while (index > 0) {
+        size_t parent = (index - 1) / 4;
+        if (!entry.IsBefore(heap_[parent])) {
+            break;
+        }
+        heap_[index] = heap_[parent];
+        index = parent;
+    }
+    heap_[index] = entry;
+}
+
+GridPathfinder::HeapEntry GridPathfinder::PopHeap() {
+    HeapEntry top = heap_.front();
+    HeapEntry last = heap_.back();
+    heap_.pop_back();
+    size_t size = heap_.size();
+    if (size == 0) {
+        return top;
+    }
+
+    size_t index = 0;
+    for (;;) {
+        size_t first_child = index * 4 + 1;
+        if (first_child >= size) {
+            break;
+        }
+        size_t best = first_child;
+        size_t last_child = std::min(first_child + 4, size);
+        for (size_t child = first_child + 1; child < last_child; ++child) {
+            if (heap_[child].IsBefore(heap_[best])) {
+                best = child;
+            }
+        }
+        if (!heap_[best].IsBefore(last)) {
+            break;
+        }
+        heap_[index] = heap_[best];
+        index = best;
+    }
+    heap_[index] = last;
+    return top;
+}
+
+} // namespace Simulation
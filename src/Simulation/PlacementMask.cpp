@@ -0,0 +1,222 @@
+#include "Simulation/PlacementMask.h"
+#include <bit>
+
+namespace Simulation {
+
+void PlacementMask::BuildAll(const CellGrid& cells, std::span<const PlacementRule> rules,
+                             std::vector<PlacementMask>& masks) {
+    u16 width = cells.GetWidth();
+    u16 height = cells.GetHeight();
+    u32 words_per_row = (static_cast<u32>(width) + 63) / 64;
+    size_t type_count = cells.GetTypeCount();
+
+    masks.resize(rules.size());
+    for (size_t t = 0; t < rules.size(); ++t) {
+        PlacementMask& mask = masks[t];
+        mask.rule_ = rules[t];
+        mask.width_ = width;
+        mask.height_ = height;
+        mask.words_per_row_ = words_per_row;
+        mask.bits_.assign(static_cast<size_t>(words_per_row) * height, 0);
+        mask.row_counts_.assign(height, 0);
+    }
+    if (width == 0 || height == 0) {
+        return;
+    }
+
+    // Bit planes per cell type for three rows (previous, current, next);
+    // rows outside the grid stay empty
+    std::vector<u64> planes[3];
+    for (auto& plane : planes) {
+        plane.assign(type_count * words_per_row, 0);
+    }
+    auto fill_planes = [&](std::vector<u64>& plane, u16 y) {
+        std::fill(plane.begin(), plane.end(), 0);
+        std::span<const CellGrid::TypeID> row = cells.GetTypes().subspan(static_cast<size_t>(y) * width, width);
+        for (u32 x = 0; x < width; ++x) {
+            plane[static_cast<size_t>(row[x]) * words_per_row + (x >> 6)] |= u64{1} << (x & 63);
+        }
+    };
+    std::vector<u64>* previous = &planes[0];
+    std::vector<u64>* current = &planes[1];
+    std::vector<u64>* next = &planes[2];
+    std::fill(previous->begin(), previous->end(), 0);
+    fill_planes(*current, 0);
+
+    std::vector<u64> allowed(words_per_row);
+    std::vector<u64> bad_above(words_per_row);
+    std::vector<u64> bad_row(words_per_row);
+    std::vector<u64> bad_below(words_per_row);
+    u64 last_word_bits = (width & 63) ? (u64{1} << (width & 63)) - 1 : ~u64{0};
+
+    for (u16 y = 0; y < height; ++y) {
+        if (y + 1 < height) {
+            fill_planes(*next, static_cast<u16>(y + 1));
+        } else {
+            std::fill(next->begin(), next->end(), 0);
+        }
+
+        for (size_t t = 0; t < rules.size(); ++t) {
+            const PlacementRule& rule = rules[t];
+            PlacementMask& mask = masks[t];
+
+            if (((rule.blocked_rims & PlacementRule::RIM_TOP) && y == 0) ||
+                ((rule.blocked_rims & PlacementRule::RIM_BOTTOM) && y == height - 1)) {
+                continue;
+            }
+
+            // Allowed and incompatible cells of the three rows, as ORs of planes
+            std::fill(allowed.begin(), allowed.end(), 0);
+            std::fill(bad_above.begin(), bad_above.end(), 0);
+            std::fill(bad_row.begin(), bad_row.end(), 0);
+            std::fill(bad_below.begin(), bad_below.end(), 0);
+            for (size_t type = 0; type < type_count; ++type) {
+                size_t offset = type * words_per_row;
+                if (rule.allowed_on[type]) {
+                    for (u32 w = 0; w < words_per_row; ++w) {
+                        allowed[w] |= (*current)[offset + w];
+                    }
+                }
+                if (rule.incompatible[type]) {
+                    for (u32 w = 0; w < words_per_row; ++w) {
+                        bad_above[w] |= (*previous)[offset + w];
+                        bad_row[w] |= (*current)[offset + w];
+                        bad_below[w] |= (*next)[offset + w];
+                    }
+                }
+            }
+
+            // 8-neighbourhood: above and below including diagonals, plus the
+            // left and right cells of this row (shifts carry across words)
+            u64* out = mask.bits_.data() + static_cast<size_t>(y) * words_per_row;
+            u32 count = 0;
+            for (u32 w = 0; w < words_per_row; ++w) {
+                u64 vertical = bad_above[w] | bad_below[w];
+                u64 spread = vertical | bad_row[w];
+                u64 from_left = spread << 1;
+                u64 from_right = spread >> 1;
+                if (w > 0) {
+                    u64 carry = bad_above[w - 1] | bad_below[w - 1] | bad_row[w - 1];
+                    from_left |= carry >> 63;
+                }
+                if (w + 1 < words_per_row) {
+                    u64 carry = bad_above[w + 1] | bad_below[w + 1] | bad_row[w + 1];
+                    from_right |= carry << 63;
+                }
+                u64 blocked = vertical | from_left | from_right;
+                u64 word = allowed[w] & ~blocked;
+                if (w + 1 == words_per_row) {
+                    word &= last_word_bits;
+                }
+                out[w] = word;
+            }
+            if (rule.blocked_rims & PlacementRule::RIM_LEFT) {
+                out[0] &= ~u64{1};
+            }
+            if (rule.blocked_rims & PlacementRule::RIM_RIGHT) {
+                out[(width - 1u) >> 6] &= ~(u64{1} << ((width - 1u) & 63));
+            }
+            for (u32 w = 0; w < words_per_row; ++w) {
+                count += static_cast<u32>(std::popcount(out[w]));
+            }
+            mask.row_counts_[y] = count;
+        }
+
+        std::vector<u64>* recycled = previous;
+        previous = current;
+        current = next;
+        next = recycled;
+    }
+}
+
+void PlacementMask::Update(const CellGrid& cells, u32 cell) {
+    u16 cx = cells.GetCellX(cell);
+    u16 cy = cells.GetCellY(cell);
+    for (i32 y = static_cast<i32>(cy) - 1; y <= static_cast<i32>(cy) + 1; ++y) {
+        if (y < 0 || y >= height_) {
+            continue;
+        }
+        for (i32 x = static_cast<i32>(cx) - 1; x <= static_cast<i32>(cx) + 1; ++x) {
+            if (x < 0 || x >= width_) {
+                continue;
+            }
+            SetBit(static_cast<u16>(x), static_cast<u16>(y), Evaluate(cells, static_cast<u16>(x), static_cast<u16>(y)));
+        }
+    }
+}
+
+u32 PlacementMask::CountRows(u16 first_row, u16 end_row) const {
+    u32 count = 0;
+    for (u32 y = first_row; y < end_row && y < height_; ++y) {
+        count += row_counts_[y];
+    }
+    return count;
+}
+
+u32 PlacementMask::FindNth(u16 first_row, u16 end_row, u32 n) const {
+    for (u32 y = first_row; y < end_row && y < height_; ++y) {
+        if (n >= row_counts_[y]) {
+            n -= row_counts_[y];
+            continue;
+        }
+        const u64* row = bits_.data() + static_cast<size_t>(y) * words_per_row_;
+        for (u32 w = 0; w < words_per_row_; ++w) {
+            u32 word_count = static_cast<u32>(std::popcount(row[w]));
+            if (n >= word_count) {
+                n -= word_count;
+                continue;
+            }
+            // Drop the n lowest set bits; the next one is the answer
+            u64 word = row[w];
+            for (u32 i = 0; i < n; ++i) {
+                word &= word - 1;
+            }
+            return y * width_ + w * 64 + static_cast<u32>(std::countr_zero(word));
+        }
+    }
+    return NO_CELL;
+}
+
+bool PlacementMask::Evaluate(const CellGrid& cells, u16 x, u16 y) const {
+    if (!rule_.allowed_on[cells.GetType(x, y)]) {
+        return false;
+    }
+    if (((rule_.blocked_rims & PlacementRule::RIM_TOP) && y == 0) ||
+        ((rule_.blocked_rims & PlacementRule::RIM_BOTTOM) && y == height_ - 1) ||
+        ((rule_.blocked_rims & PlacementRule::RIM_LEFT) && x == 0) ||
+        ((rule_.blocked_rims & PlacementRule::RIM_RIGHT) && x == width_ - 1)) {
+        return false;
+    }
+    for (i32 dy = -1; dy <= 1; ++dy) {
+        for (i32 dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dy == 0) continue;
+            i32 nx = static_cast<i32>(x) + dx;
+            i32 ny = static_cast<i32>(y) + dy;
+            if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_) {
+                continue;
+            }
+            if (rule_.incompatible[cells.GetType(static_cast<u16>(nx), static_cast<u16>(ny))]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void PlacementMask::SetBit(u16 x, u16 y, bool placeable) {
+    u64& word = bits_[static_cast<size_t>(y) * words_per_row_ + (x >> 6)];
+    u64 bit = u64{1} << (x & 63);
+    bool was_placeable = (word & bit) != 0;
+    if (placeable == was_placeable) {
+        return;
+    }
+    if (placeable) {
+        word |= bit;
+        ++row_counts_[y];
+    } else {
+        word &= ~bit;
+        --row_counts_[y];
+    }
+}
+
+} // namespace Simulation
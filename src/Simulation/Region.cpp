@@ -1,4 +1,7 @@
 #include "Simulation/Region.h"
+#include <algorithm>
+#include <istream>
+#include <ostream>
 
 namespace Simulation {
 
@@ -9,7 +12,24 @@ Region::Region(RegionID id, const std::string& type)
 Region::~Region() = default;
 
 void Region::Initialize() {
-    // TODO: Implement initialization
+    // Seed capacity and resource slots from the region definition
+    auto& config = Config::Configuration::GetInstance();
+    auto it = config.regions.region_definitions.find(type_);
+    if (it == config.regions.region_definitions.end()) {
+        return;
+    }
+    
+    const RegionDefinition& def = it->second;
+    capacity_ = def.capacity;
+    
+    f32 resource_capacity = static_cast<f32>(capacity_) * config.simulation.region.max_capacity_multiplier;
+    for (const auto& resource_type : def.resource_types) {
+        ResourceIndex index = config.regions.GetResourceIndex(resource_type);
+        if (index != INVALID_RESOURCE_INDEX) {
+            resource_capacity_[index] = resource_capacity;
+            resources_[index] = resource_capacity;
+        }
+    }
 }
 
 void Region::Update(f32 delta_time, SimulationLOD lod, Tick current_tick) {
@@ -37,38 +57,83 @@ bool Region::IsAtCapacity() const {
     return population_count_ >= capacity_;
 }
 
-f32 Region::GetResource(const std::string& resource_type) const {
-    auto it = resources_.find(resource_type);
-    if (it != resources_.end()) {
-        return it->second;
+f32 Region::GetResource(ResourceIndex index) const {
+    if (index >= MAX_RESOURCES) {
+        return 0.0f;
     }
-    return 0.0f;
+    return resources_[index];
+}
+
+void Region::SetResource(ResourceIndex index, f32 value) {
+    if (index < MAX_RESOURCES) {
+        resources_[index] = value;
+    }
+}
+
+void Region::ModifyResource(ResourceIndex index, f32 delta) {
+    if (index < MAX_RESOURCES) {
+        resources_[index] += delta;
+    }
+}
+
+f32 Region::GetResourceCapacity(ResourceIndex index) const {
+    if (index >= MAX_RESOURCES) {
+        return 0.0f;
+    }
+    return resource_capacity_[index];
+}
+
+void Region::SetResourceCapacity(ResourceIndex index, f32 capacity) {
+    if (index < MAX_RESOURCES) {
+        resource_capacity_[index] = capacity;
+    }
+}
+
+f32 Region::GetResource(const std::string& resource_type) const {
+    return GetResource(Config::Configuration::GetInstance().regions.GetResourceIndex(resource_type));
 }
 
 void Region::SetResource(const std::string& resource_type, f32 value) {
-    resources_[resource_type] = value;
+    SetResource(Config::Configuration::GetInstance().regions.GetResourceIndex(resource_type), value);
 }
 
 void Region::ModifyResource(const std::string& resource_type, f32 delta) {
-    resources_[resource_type] += delta;
+    ModifyResource(Config::Configuration::GetInstance().regions.GetResourceIndex(resource_type), delta);
+}
+
+void Region::RegenerateResources(f32 amount_per_capacity) {
+    // All MAX_RESOURCES slots are processed unconditionally so the loop
+    // compiles to a couple of vector min/fma ops; empty slots stay at zero.
+    for (u8 i = 0; i < MAX_RESOURCES; ++i) {
+        f32 regenerated = resources_[i] + resource_capacity_[i] * amount_per_capacity;
+        resources_[i] = std::min(regenerated, resource_capacity_[i]);
+    }
 }
 
 void Region::SetTrait(u8 category, u8 trait_id, bool value) {
-    // TODO: Implement trait system
-    (void)category;
-    (void)trait_id;
-    (void)value;
+    if (category >= MAX_TRAIT_CATEGORIES || trait_id >= 64) {
+        return;
+    }
+    u64 bit = u64{1} << trait_id;
+    if (value) {
+        traits_[category] |= bit;
+    } else {
+        traits_[category] &= ~bit;
+    }
 }
 
 bool Region::GetTrait(u8 category, u8 trait_id) const {
-    // TODO: Implement trait system
-    (void)category;
-    (void)trait_id;
-    return false;
+    if (category >= MAX_TRAIT_CATEGORIES || trait_id >= 64) {
+        return false;
+    }
+    return (traits_[category] >> trait_id) & u64{1};
 }
 
-void Region::AddNeighbor(RegionID neighbor_id) {
-    neighbors_.push_back(neighbor_id);
+u64 Region::GetTraitMask(u8 category) const {
+    if (category >= MAX_TRAIT_CATEGORIES) {
+        return 0;
+    }
+    return traits_[category];
 }
 
 void Region::SetPosition(f32 x, f32 y) {
@@ -115,6 +180,65 @@ f32 Region::GetSkillStdDev(SkillID skill_id) const {
     return 0.0f;
 }
 
+void Region::WriteState(std::ostream& out) const {
+    u32 subtype_length = static_cast<u32>(subtype_.size());
+    u32 influence_count = static_cast<u32>(hero_influences_.size());
+    out.write(reinterpret_cast<const char*>(&population_count_), sizeof(population_count_));
+    out.write(reinterpret_cast<const char*>(&capacity_), sizeof(capacity_));
+    out.write(reinterpret_cast<const char*>(&subtype_length), sizeof(subtype_length));
+    out.write(subtype_.data(), subtype_length);
+    out.write(reinterpret_cast<const char*>(resources_.data()), sizeof(resources_));
+    out.write(reinterpret_cast<const char*>(resource_capacity_.data()), sizeof(resource_capacity_));
+    out.write(reinterpret_cast<const char*>(traits_.data()), sizeof(traits_));
+    out.write(reinterpret_cast<const char*>(&influence_count), sizeof(influence_count));
+    for (const auto& [hero_id, strength] : hero_influences_) {
+        out.write(reinterpret_cast<const char*>(&hero_id), sizeof(hero_id));
+        out.write(reinterpret_cast<const char*>(&strength), sizeof(strength));
+    }
+    for (const std::vector<f32>* skills : {&skill_means_, &skill_std_devs_}) {
+        u32 skill_count = static_cast<u32>(skills->size());
+        out.write(reinterpret_cast<const char*>(&skill_count), sizeof(skill_count));
+        out.write(reinterpret_cast<const char*>(skills->data()), skill_count * sizeof(f32));
+    }
+}
+
+bool Region::ReadState(std::istream& in) {
+    u32 subtype_length = 0;
+    in.read(reinterpret_cast<char*>(&population_count_), sizeof(population_count_));
+    in.read(reinterpret_cast<char*>(&capacity_), sizeof(capacity_));
+    in.read(reinterpret_cast<char*>(&subtype_length), sizeof(subtype_length));
+    if (!in || subtype_length > 0xFFFF) {
+        return false;
+    }
+    subtype_.resize(subtype_length);
+    in.read(subtype_.data(), subtype_length);
+    in.read(reinterpret_cast<char*>(resources_.data()), sizeof(resources_));
+    in.read(reinterpret_cast<char*>(resource_capacity_.data()), sizeof(resource_capacity_));
+    in.read(reinterpret_cast<char*>(traits_.data()), sizeof(traits_));
+    
+    u32 influence_count = 0;
+    in.read(reinterpret_cast<char*>(&influence_count), sizeof(influence_count));
+    hero_influences_.clear();
+    for (u32 i = 0; i < influence_count && in; ++i) {
+        EntityID hero_id = INVALID_ENTITY_ID;
+        f32 strength = 0.0f;
+        in.read(reinterpret_cast<char*>(&hero_id), sizeof(hero_id));
+        in.read(reinterpret_cast<char*>(&strength), sizeof(strength));
+        hero_influences_[hero_id] = strength;
+    }
+    
+    for (std::vector<f32>* skills : {&skill_means_, &skill_std_devs_}) {
+        u32 skill_count = 0;
+        in.read(reinterpret_cast<char*>(&skill_count), sizeof(skill_count));
+        if (!in || skill_count > 0xFFFF) {
+            return false;
+        }
+        skills->resize(skill_count);
+        in.read(reinterpret_cast<char*>(skills->data()), skill_count * sizeof(f32));
+    }
+    return static_cast<bool>(in);
+}
+
 void Region::UpdateFullSimulation(f32 delta_time) {
     // TODO: Implement full simulation
     (void)delta_time;
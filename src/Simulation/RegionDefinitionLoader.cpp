@@ -1,7 +1,7 @@
 #include "Simulation/RegionDefinition.h"
 #include "Core/Config.h"
+#include "Utils/Logger.h"
 #include <nlohmann/json.hpp>
-#include <iostream>
 #include <fstream>
 #include <sstream>
 
@@ -16,8 +16,8 @@ void LoadRegionDefinitions(Config::RegionsConfig& regions_config) {
     // Try to open the JSON file
     std::ifstream file(json_path);
     if (!file.is_open()) {
-        std::cerr << "RegionDefinitionLoader: Failed to open JSON file: " << json_path << std::endl;
-        std::cerr << "RegionDefinitionLoader: Falling back to hardcoded definitions" << std::endl;
+        LOG_ERROR("RegionDefinitionLoader: Failed to open JSON file: " << json_path);
+        LOG_WARNING("RegionDefinitionLoader: Falling back to hardcoded definitions");
         // Fall back to hardcoded if file not found
         return;
     }
@@ -29,7 +29,7 @@ void LoadRegionDefinitions(Config::RegionsConfig& regions_config) {
         
         // Parse regions array
         if (!json_data.contains("regions") || !json_data["regions"].is_array()) {
-            std::cerr << "RegionDefinitionLoader: Invalid JSON structure - missing 'regions' array" << std::endl;
+            LOG_ERROR("RegionDefinitionLoader: Invalid JSON structure - missing 'regions' array");
             return;
         }
         
@@ -38,7 +38,7 @@ void LoadRegionDefinitions(Config::RegionsConfig& regions_config) {
             
             // Required fields
             if (!region_json.contains("type") || !region_json["type"].is_string()) {
-                std::cerr << "RegionDefinitionLoader: Skipping region - missing or invalid 'type'" << std::endl;
+                LOG_WARNING("RegionDefinitionLoader: Skipping region - missing or invalid 'type'");
                 continue;
             }
             def.type = region_json["type"].get<std::string>();
@@ -118,17 +118,17 @@ void LoadRegionDefinitions(Config::RegionsConfig& regions_config) {
             regions_config.region_definitions[def.type] = def;
         }
         
-        std::cout << "RegionDefinitionLoader: Loaded " << regions_config.region_definitions.size() 
-                  << " region definitions from " << json_path << std::endl;
+        LOG_INFO("RegionDefinitionLoader: Loaded " << regions_config.region_definitions.size() 
+              << " region definitions from " << json_path);
         
     } catch (const nlohmann::json::exception& e) {
-        std::cerr << "RegionDefinitionLoader: JSON parsing error: " << e.what() << std::endl;
-        std::cerr << "RegionDefinitionLoader: Falling back to hardcoded definitions" << std::endl;
+        LOG_ERROR("RegionDefinitionLoader: JSON parsing error: " << e.what());
+        LOG_WARNING("RegionDefinitionLoader: Falling back to hardcoded definitions");
         file.close();
         return;
     } catch (const std::exception& e) {
-        std::cerr << "RegionDefinitionLoader: Error loading JSON: " << e.what() << std::endl;
-        std::cerr << "RegionDefinitionLoader: Falling back to hardcoded definitions" << std::endl;
+        LOG_ERROR("RegionDefinitionLoader: Error loading JSON: " << e.what());
+        LOG_WARNING("RegionDefinitionLoader: Falling back to hardcoded definitions");
         file.close();
         return;
     }
@@ -0,0 +1,109 @@
+#include "Simulation/SettlementSampler.h"
+#include <cmath>
+
+namespace Simulation {
+
+void SettlementSampler::Reset(u16 grid_width, u16 grid_height, u16 min_distance) {
+    grid_width_ = grid_width;
+    grid_height_ = grid_height;
+    min_distance_ = min_distance > 0 ? min_distance : 1;
+    buckets_x_ = static_cast<u16>((static_cast<u32>(grid_width) + min_distance_ - 1) / min_distance_);
+    buckets_y_ = static_cast<u16>((static_cast<u32>(grid_height) + min_distance_ - 1) / min_distance_);
+    points_.clear();
+    point_next_.clear();
+    bucket_heads_.assign(static_cast<size_t>(buckets_x_) * buckets_y_, NO_CELL);
+    ClearCandidates();
+}
+
+void SettlementSampler::Insert(u16 x, u16 y) {
+    u32 bucket = static_cast<u32>(y / min_distance_) * buckets_x_ + x / min_distance_;
+    point_next_.push_back(bucket_heads_[bucket]);
+    bucket_heads_[bucket] = static_cast<u32>(points_.size());
+    points_.emplace_back(x, y);
+}
+
+bool SettlementSampler::IsFarEnough(u16 x, u16 y) const {
+    // Buckets are min_distance wide, so closer settlements are in the 3x3 block
+    i32 bucket_x = x / min_distance_;
+    i32 bucket_y = y / min_distance_;
+    i64 limit = static_cast<i64>(min_distance_) * min_distance_;
+    for (i32 by = std::max(bucket_y - 1, 0); by <= std::min(bucket_y + 1, buckets_y_ - 1); ++by) {
+        for (i32 bx = std::max(bucket_x - 1, 0); bx <= std::min(bucket_x + 1, buckets_x_ - 1); ++bx) {
+            for (u32 i = bucket_heads_[static_cast<u32>(by) * buckets_x_ + bx]; i != NO_CELL; i = point_next_[i]) {
+                i64 dx = static_cast<i64>(x) - points_[i].first;
+                i64 dy = static_cast<i64>(y) - points_[i].second;
+                if (dx * dx + dy * dy < limit) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+u64 SettlementSampler::GetNearestSquaredDistance(u16 x, u16 y) const {
+    u64 best = 0xFFFFFFFFFFFFFFFFull;
+    auto visit = [&](u32 i) {
+        i64 dx = static_cast<i64>(x) - points_[i].first;
+        i64 dy = static_cast<i64>(y) - points_[i].second;
+        best = std::min(best, static_cast<u64>(dx * dx + dy * dy));
+    };
+
+    if (points_.size() <= LINEAR_SEARCH_LIMIT) {
+        for (u32 i = 0; i < points_.size(); ++i) {
+            visit(i);
+        }
+        return best;
+    }
+
+    // Walk square rings of buckets; after ring r, every unvisited settlement
+    // is more than r * min_distance away on some axis
+    i32 bucket_x = x / min_distance_;
+    i32 bucket_y = y / min_distance_;
+    i32 max_ring = std::max<i32>(buckets_x_, buckets_y_);
+    for (i32 ring = 0; ring <= max_ring; ++ring) {
+        for (i32 by = bucket_y - ring; by <= bucket_y + ring; ++by) {
+            if (by < 0 || by >= buckets_y_) {
+                continue;
+            }
+            // Full rows at the top and bottom of the ring, only the ends elsewhere
+            i32 step = (by == bucket_y - ring || by == bucket_y + ring) ? 1 : std::max(2 * ring, 1);
+            for (i32 bx = bucket_x - ring; bx <= bucket_x + ring; bx += step) {
+                if (bx < 0 || bx >= buckets_x_) {
+                    continue;
+                }
+                for (u32 i = bucket_heads_[static_cast<u32>(by) * buckets_x_ + bx]; i != NO_CELL; i = point_next_[i]) {
+                    visit(i);
+                }
+            }
+        }
+        u64 reach = static_cast<u64>(ring) * min_distance_;
+        if (best <= reach * reach) {
+            break;
+        }
+    }
+    return best;
+}
+
+void SettlementSampler::AddCandidate(u32 cell, f32 jitter) {
+    heap_.push_back({Score(cell, jitter), jitter, cell, GetCount()});
+    heap_ready_ = false;
+}
+
+f32 SettlementSampler::Score(u32 cell, f32 jitter) const {
+    if (!score_by_distance_) {
+        return jitter;
+    }
+    // Without settlements every cell counts as a grid diagonal away, which
+    // keeps scores from rising as settlements are added
+    if (points_.empty()) {
+        f32 diagonal = std::sqrt(static_cast<f32>(grid_width_) * grid_width_ +
+                                 static_cast<f32>(grid_height_) * grid_height_);
+        return diagonal * jitter;
+    }
+    u64 distance_sq = GetNearestSquaredDistance(static_cast<u16>(cell % grid_width_),
+                                                 static_cast<u16>(cell / grid_width_));
+    return std::sqrt(static_cast<f32>(distance_sq)) * jitter;
+}
+
+} // namespace Simulation
@@ -1,5 +1,4 @@
 #include <algorithm>
-#include <iostream>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -15,6 +14,7 @@
 #include "Simulation/StandardWorldGenerator.h"
 #include "Core/Config.h"
 #include "Utils/Random.h"
+#include "Utils/Logger.h"
 
 namespace Simulation {
 
@@ -92,8 +92,14 @@ void SimulationManager::UpdateLOD() {
 }
 
 void SimulationManager::UpdateRegions(f32 delta_time) {
-    // TODO: Implement region updates
-    (void)delta_time;
+    if (!world_) {
+        return;
+    }
+    
+    // Resources regenerate uniformly regardless of LOD
+    world_->RegenerateResources(delta_time);
+    
+    // TODO: Implement per-LOD region updates
 }
 
 void SimulationManager::ProcessLODTransitions() {
@@ -101,7 +107,7 @@ void SimulationManager::ProcessLODTransitions() {
 }
 
 void SimulationManager::InitializeRegionGrid(u16 grid_width, u16 grid_height, f32 region_size) {
-    std::cout << "SimulationManager: Initializing region grid using world generator..." << std::endl;
+    LOG_INFO("SimulationManager: Initializing region grid using world generator...");
     
     // Create world generator
     world_generator_ = std::make_unique<StandardWorldGenerator>();
@@ -110,12 +116,11 @@ void SimulationManager::InitializeRegionGrid(u16 grid_width, u16 grid_height, f3
     world_ = world_generator_->Generate(grid_width, grid_height, region_size);
     
     if (!world_) {
-        std::cout << "SimulationManager: ERROR - Failed to generate world!" << std::endl;
+        LOG_ERROR("SimulationManager: ERROR - Failed to generate world!");
         return;
     }
     
-    std::cout << "SimulationManager: World generated successfully" << std::endl;
-    std::cout << "SimulationManager: Created " << world_->GetRegions().size() << " regions" << std::endl;
+    LOG_INFO("SimulationManager: World generated successfully, " << world_->GetRegions().size() << " regions");
 }
 
 } // namespace Simulation
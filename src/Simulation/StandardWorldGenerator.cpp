@@ -1,13 +1,17 @@
 #include "Simulation/StandardWorldGenerator.h"
 #include "Simulation/World.h"
+#include "Simulation/ChunkedWorld.h"
+#include "Simulation/WorldCache.h"
 #include "Simulation/Region.h"
 #include "Simulation/RegionDefinition.h"
 #include "Simulation/RegionDefinitionLoader.h"
 #include "Core/Config.h"
 #include "Utils/Random.h"
+#include "Utils/Hash.h"
+#include "Utils/JobSystem.h"
+#include "Utils/Logger.h"
 #include <algorithm>
 #include <cmath>
-#include <iostream>
 #include <limits>
 #include <unordered_set>
 #include <unordered_map>
@@ -15,30 +19,108 @@
 
 namespace Simulation {
 
-StandardWorldGenerator::StandardWorldGenerator() {
-    random_ = &Utils::Random::GetInstance();
+namespace {
+// FNV-1a, so stream keys do not depend on type ID assignment order
+u64 HashTypeName(const std::string& type) {
+    return Utils::Fnv1a().AddBytes(type.data(), type.size()).Get();
 }
 
+// Coastal borders in the order of their bits in cached layout state
+const char* const BORDER_NAMES[4] = {"top", "bottom", "left", "right"};
+}
+
+thread_local StandardWorldGenerator::ExpansionScratch StandardWorldGenerator::expansion_scratch_;
+
+StandardWorldGenerator::StandardWorldGenerator() = default;
+
 std::unique_ptr<World> StandardWorldGenerator::Generate(u16 grid_width, u16 grid_height, f32 region_size) {
-    grid_width_ = grid_width;
-    grid_height_ = grid_height;
-    region_size_ = region_size;
+    auto start_time = std::chrono::steady_clock::now();
+    auto world = std::make_unique<World>();
+    world->Initialize(grid_width, grid_height, region_size);
     
-    // Reset state for new generation
-    desert_hemisphere_set_ = false;
-    desert_northern_hemisphere_ = false;
-    forest_hemisphere_set_ = false;
-    forest_northern_hemisphere_ = false;
-    coastal_borders_.clear();
+    if (!RunPasses(world.get())) {
+        Utils::Logger::GetInstance().Flush();
+        return world;
+    }
+    
+    // Cell types are final; build the regions and the shared adjacency once
+    BeginPass("Materialize");
+    MaterializeRegions(world.get());
+    world->BuildAdjacency();
+    EndPass();
     
+    report_.total_time_ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+    LOG_INFO("StandardWorldGenerator: World generation complete in " << report_.total_time_ms << " ms");
+    LOG_INFO("StandardWorldGenerator: Created " << world->GetRegions().size() << " regions, "
+             << world->GetSourceRegions().size() << " source regions, "
+             << world->GetSettlements().size() << " settlements, "
+             << world->GetRoads().size() << " roads");
+    Utils::Logger::GetInstance().Flush();
+    
+    return world;
+}
+
+std::unique_ptr<ChunkedWorld> StandardWorldGenerator::GenerateChunked(u16 grid_width, u16 grid_height,
+                                                                      f32 region_size, u16 chunk_size) {
+    auto start_time = std::chrono::steady_clock::now();
     auto world = std::make_unique<World>();
     world->Initialize(grid_width, grid_height, region_size);
     
-    std::cout << "StandardWorldGenerator: Starting world generation" << std::endl;
+    if (!RunPasses(world.get())) {
+        Utils::Logger::GetInstance().Flush();
+        return nullptr;
+    }
+    
+    // Only the grid is handed over; drop the per-cell pass scratch first
+    coastal_index_ = FeatureIndex();
+    feature_sites_ = std::vector<u8>();
+    road_pathfinder_ = GridPathfinder();
+    
+    auto chunked = std::make_unique<ChunkedWorld>(std::move(world), std::move(cells_), chunk_size);
+    
+    report_.total_time_ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+    LOG_INFO("StandardWorldGenerator: World generation complete in " << report_.total_time_ms << " ms");
+    LOG_INFO("StandardWorldGenerator: Created " << chunked->GetChunksX() * chunked->GetChunksY()
+             << " chunks of up to " << chunk_size << "x" << chunk_size << " regions, "
+             << chunked->GetWorld().GetSourceRegions().size() << " source regions, "
+             << chunked->GetWorld().GetSettlements().size() << " settlements, "
+             << chunked->GetWorld().GetRoads().size() << " roads");
+    Utils::Logger::GetInstance().Flush();
+    
+    return chunked;
+}
+
+bool StandardWorldGenerator::RunPasses(World* world) {
+    grid_width_ = world->GetGridWidth();
+    grid_height_ = world->GetGridHeight();
+    region_size_ = world->GetRegionSize();
     
     // Get region definitions from config
     auto& config = Config::Configuration::GetInstance();
     
+    // Every pass and source draws from its own stream derived from this seed.
+    // A seed reproduces the same world, so with the cache on, a drawn seed is
+    // kept in the cache directory and reused, and the world it made is loaded
+    WorldCache cache(config.world.world_cache_directory);
+    bool cacheable = config.world.world_cache_enabled;
+    bool cache_passes = cacheable && config.world.world_cache_passes;
+    seed_ = requested_seed_ != 0 ? requested_seed_ : config.world.world_seed;
+    if (seed_ == 0 && cacheable) {
+        seed_ = cache.LoadSeed();
+    }
+    if (seed_ == 0) {
+        while (seed_ == 0) {
+            seed_ = Utils::Random::GetInstance().RandomU64();
+        }
+        if (cacheable) {
+            cache.SaveSeed(seed_);
+        }
+    }
+    report_ = GenerationReport();
+    report_.seed = seed_;
+    
+    LOG_INFO("StandardWorldGenerator: Starting world generation (seed " << seed_ << ")");
+    
     // Load region definitions if not already loaded
     if (config.regions.region_definitions.empty()) {
         LoadRegionDefinitions(config.regions);
@@ -47,93 +129,407 @@ std::unique_ptr<World> StandardWorldGenerator::Generate(u16 grid_width, u16 grid
     const auto& region_definitions = config.regions.region_definitions;
     
     if (region_definitions.empty()) {
-        std::cout << "StandardWorldGenerator: WARNING - No region definitions loaded!" << std::endl;
-        return world;
+        LOG_WARNING("StandardWorldGenerator: WARNING - No region definitions loaded!");
+        return false;
     }
     
-    // Pass 0: Initialize all regions as Plains
-    Pass0_InitializePlains(world.get());
+    BuildTypeTable(region_definitions);
+    std::vector<GenerationPass> pipeline = BuildPipeline(region_definitions);
+    
+    // Every input must come from an earlier pass, and the state after a pass
+    // is keyed by the passes up to it: a changed pass invalidates only the
+    // cached state from that pass on
+    std::vector<u64> pass_hashes(pipeline.size());
+    u32 written = 0;
+    u64 content_hash = HashTypeTable();
+    for (size_t i = 0; i < pipeline.size(); ++i) {
+        const GenerationPass& pass = pipeline[i];
+        if ((pass.inputs & ~written) != 0) {
+            LOG_ERROR("StandardWorldGenerator: ERROR - Pass " << pass.name
+                      << " reads data no earlier pass writes");
+            return false;
+        }
+        written |= pass.outputs;
+        content_hash = Utils::Fnv1a().Add(content_hash).Add(pass.name).Add(pass.inputs)
+                           .Add(pass.outputs).Add(pass.content_hash).Get();
+        pass_hashes[i] = content_hash;
+    }
+    
+    WorldCache::Key cache_key;
+    cache_key.grid_width = grid_width_;
+    cache_key.grid_height = grid_height_;
+    cache_key.seed = seed_;
+    cache_key.generator_version = GENERATOR_VERSION;
+    
+    // Resume after the latest pass with cached state (only the final state
+    // is cached unless world.world_cache_passes is set)
+    size_t first_pass = 0;
+    if (cacheable) {
+        std::vector<u8> layout_state;
+        size_t lowest = cache_passes ? 0 : pipeline.size() - 1;
+        for (size_t i = pipeline.size(); i-- > lowest;) {
+            cache_key.content_hash = pass_hashes[i];
+            if (cache.Load(cache_key, cells_, *world, layout_state)) {
+                RestoreLayoutState(layout_state);
+                first_pass = i + 1;
+                break;
+            }
+        }
+    }
+    for (size_t i = 0; i < first_pass; ++i) {
+        PassReport pass;
+        pass.name = pipeline[i].name;
+        pass.content_hash = pass_hashes[i];
+        pass.from_cache = true;
+        report_.passes.push_back(pass);
+    }
+    if (first_pass == pipeline.size()) {
+        report_.from_cache = true;
+        LOG_INFO("StandardWorldGenerator: Loaded world from cache " << cache.GetPath(cache_key));
+        return true;
+    }
+    if (first_pass > 0) {
+        LOG_INFO("StandardWorldGenerator: Resuming after pass " << pipeline[first_pass - 1].name
+                 << " from cache " << cache.GetPath(cache_key));
+        BuildPlacementMasks();
+    }
+    
+    PassContext context;
+    context.world = world;
+    context.cells = &cells_;
+    context.seed = seed_;
+    // Intermediate state is saved once the passes since the last save took
+    // longer than that save did; cheaper runs of passes are re-run instead
+    f64 unsaved_ms = 0.0;
+    f64 save_ms = 0.0;
+    for (size_t i = first_pass; i < pipeline.size(); ++i) {
+        const GenerationPass& pass = pipeline[i];
+        BeginPass(pass.name);
+        CurrentPass().content_hash = pass_hashes[i];
+        pass.run(context);
+        EndPass();
+        unsaved_ms += CurrentPass().wall_time_ms;
+        
+        bool last = i + 1 == pipeline.size();
+        if (!(cacheable && last) && !(cache_passes && pass.outputs != 0 && unsaved_ms >= save_ms)) {
+            continue;
+        }
+        auto save_start = std::chrono::steady_clock::now();
+        cache_key.content_hash = pass_hashes[i];
+        if (cache.Save(cache_key, cells_, *world, SaveLayoutState())) {
+            if (last) {
+                LOG_INFO("StandardWorldGenerator: Saved world to cache " << cache.GetPath(cache_key));
+            } else {
+                LOG_DEBUG("Saved state after pass " << pass.name << " to cache " << cache.GetPath(cache_key));
+            }
+        }
+        save_ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - save_start).count();
+        unsaved_ms = 0.0;
+    }
     
-    // Special pass: Coastal (must happen first, before other regions)
-    auto coastal_it = region_definitions.find("Coastal");
-    if (coastal_it != region_definitions.end() && coastal_it->second.spawn_weight > 0.0f) {
-        Pass_Coastal(world.get(), coastal_it->second);
+    // Files of this seed and grid from an earlier pipeline can no longer be
+    // loaded; beyond that the cache is capped by size
+    if (cacheable) {
+        cache.RemoveSuperseded(cache_key, pass_hashes);
+        if (config.world.world_cache_max_size_mb > 0) {
+            cache.Trim(static_cast<u64>(config.world.world_cache_max_size_mb) << 20);
+        }
     }
     
-    // Determine generation order based on dependencies and spawn weights
-    std::vector<std::string> generation_order = DetermineGenerationOrder(region_definitions);
+    cells_.ClearChanges();
     
-    // Execute passes: create sources, then expand for each region type
-    // (Coastal is excluded from this loop as it's handled separately)
-    for (const std::string& region_type : generation_order) {
-        // Skip Coastal - already handled
-        if (region_type == "Coastal") {
-            continue;
+    return true;
+}
+
+std::vector<GenerationPass> StandardWorldGenerator::BuildPipeline(
+    const std::unordered_map<std::string, RegionDefinition>& region_definitions) {
+    
+    auto FindDefinition = [&](const std::string& type) -> const RegionDefinition* {
+        auto it = region_definitions.find(type);
+        return it != region_definitions.end() ? &it->second : nullptr;
+    };
+    // Generation inputs of a definition (not its colour, capacity or resources)
+    auto HashDefinition = [](Utils::Fnv1a& hash, const RegionDefinition* def) {
+        hash.Add(def != nullptr);
+        if (def == nullptr) {
+            return;
+        }
+        hash.Add(def->type).Add(def->spawn_weight).Add(def->expansion_weight);
+        hash.Add(def->min_source_count).Add(def->max_source_count);
+        hash.Add(def->min_expansion_size).Add(def->max_expansion_size);
+        hash.Add(static_cast<u64>(def->potential_names.size()));
+        for (const auto& name : def->potential_names) {
+            hash.Add(name);
         }
-        
-        auto it = region_definitions.find(region_type);
-        if (it == region_definitions.end()) {
+    };
+    
+    std::vector<GenerationPass> passes;
+    
+    // Pass 0: Initialize all regions as Plains
+    GenerationPass initialize;
+    initialize.name = "Initialize";
+    initialize.outputs = DATA_CELLS | DATA_SOURCES | DATA_LAYOUT;
+    initialize.run = [this](PassContext&) {
+        ResetLayoutState();
+        Pass0_InitializePlains();
+        BuildPlacementMasks();
+    };
+    passes.push_back(std::move(initialize));
+    
+    // Special pass: Coastal (must happen first, before other regions)
+    const RegionDefinition* coastal_def = FindDefinition("Coastal");
+    if (coastal_def != nullptr && coastal_def->spawn_weight > 0.0f) {
+        GenerationPass coastal;
+        coastal.name = "Coastal";
+        coastal.inputs = DATA_CELLS | DATA_LAYOUT;
+        coastal.outputs = DATA_CELLS | DATA_SOURCES | DATA_LAYOUT;
+        Utils::Fnv1a hash;
+        HashDefinition(hash, coastal_def);
+        coastal.content_hash = hash.Get();
+        coastal.run = [this, def = *coastal_def](PassContext& context) {
+            random_ = Utils::RandomStream(seed_, STREAM_COASTAL);
+            Pass_Coastal(context.world, def);
+        };
+        passes.push_back(std::move(coastal));
+    }
+    
+    // Create sources, then expand, for each region type in dependency order
+    // (Coastal is handled above)
+    for (const std::string& region_type : DetermineGenerationOrder(region_definitions)) {
+        const RegionDefinition* def = FindDefinition(region_type);
+        if (region_type == "Coastal" || def == nullptr) {
             continue;
         }
         
-        const RegionDefinition& def = it->second;
-        
-        // Skip if spawn_weight is 0 (disabled) or no sources needed
-        if (def.spawn_weight <= 0.0f || def.max_source_count == 0) {
-            continue;
+        GenerationPass type_pass;
+        type_pass.name = region_type;
+        type_pass.inputs = DATA_CELLS | DATA_LAYOUT;
+        type_pass.outputs = DATA_CELLS | DATA_SOURCES | DATA_LAYOUT;  // Desert and Forest pick hemispheres
+        Utils::Fnv1a hash;
+        HashDefinition(hash, def);
+        type_pass.content_hash = hash.Get();
+        type_pass.run = [this, def = *def](PassContext& context) {
+            LOG_DEBUG("=== Pass: " << def.type << " ===");
+            random_ = Utils::RandomStream(seed_, STREAM_SOURCES, HashTypeName(def.type));
+            std::vector<RegionID> sources_created = Pass_CreateSources(context.world, def.type, def);
+            
+            if (!sources_created.empty() && def.max_expansion_size > 0) {
+                LOG_DEBUG("Expanding " << sources_created.size() << " " << def.type << " sources...");
+                ExpandSources(sources_created, def);
+            }
+        };
+        passes.push_back(std::move(type_pass));
+    }
+    
+    // Special passes for regions that don't follow standard source/expand pattern;
+    // they share one copy of the definitions, so passes never refer to the config
+    auto definitions = std::make_shared<const std::unordered_map<std::string, RegionDefinition>>(region_definitions);
+    GenerationPass rivers;
+    rivers.name = "Rivers";
+    rivers.inputs = DATA_CELLS | DATA_LAYOUT;
+    rivers.outputs = DATA_CELLS | DATA_SOURCES;
+    Utils::Fnv1a rivers_hash;
+    HashDefinition(rivers_hash, FindDefinition("RiverSource"));
+    HashDefinition(rivers_hash, FindDefinition("River"));
+    rivers.content_hash = rivers_hash.Get();
+    rivers.run = [this, definitions](PassContext& context) {
+        random_ = Utils::RandomStream(seed_, STREAM_RIVER_SOURCES);
+        Pass_Rivers(context.world, *definitions);
+    };
+    passes.push_back(std::move(rivers));
+    
+    GenerationPass settlements;
+    settlements.name = "Settlements";
+    settlements.inputs = DATA_CELLS | DATA_SOURCES | DATA_LAYOUT;
+    settlements.outputs = DATA_CELLS | DATA_SOURCES | DATA_SETTLEMENTS;
+    Utils::Fnv1a settlements_hash;
+    HashDefinition(settlements_hash, FindDefinition("Urban"));
+    HashDefinition(settlements_hash, FindDefinition("Rural"));
+    settlements_hash.Add(Config::Configuration::GetInstance().world.extra_settlements);
+    settlements.content_hash = settlements_hash.Get();
+    settlements.run = [this, definitions](PassContext& context) {
+        random_ = Utils::RandomStream(seed_, STREAM_SETTLEMENTS);
+        Pass_Settlements(context.world, *definitions);
+    };
+    passes.push_back(std::move(settlements));
+    
+    GenerationPass roads;
+    roads.name = "Roads";
+    roads.inputs = DATA_CELLS | DATA_SOURCES | DATA_SETTLEMENTS;
+    roads.outputs = DATA_CELLS | DATA_ROADS;
+    Utils::Fnv1a roads_hash;
+    HashDefinition(roads_hash, FindDefinition("Road"));
+    roads.content_hash = roads_hash.Get();
+    roads.run = [this, definitions](PassContext& context) {
+        Pass_Roads(context.world, *definitions);
+    };
+    passes.push_back(std::move(roads));
+    
+    if (added_passes_.empty()) {
+        return passes;
+    }
+    
+    // Added passes follow their named pass in the order they were added
+    std::vector<GenerationPass> pipeline;
+    std::unordered_set<std::string> names;
+    for (GenerationPass& pass : passes) {
+        names.insert(pass.name);
+        pipeline.push_back(std::move(pass));
+        for (const auto& [after, added] : added_passes_) {
+            if (after == pipeline.back().name) {
+                pipeline.push_back(added);
+            }
         }
-        
-        std::cout << "\n=== Pass: " << region_type << " ===" << std::endl;
-        
-        // Step 1: Create source regions for this type
-        std::vector<RegionID> sources_created = Pass_CreateSources(world.get(), region_type, def);
-        
-        // Step 2: Expand from each source
-        if (!sources_created.empty() && def.max_expansion_size > 0) {
-            std::cout << "Expanding " << sources_created.size() << " " << region_type << " sources..." << std::endl;
-            for (RegionID source_id : sources_created) {
-                Pass_ExpandFromSource(world.get(), source_id, def);
+    }
+    for (const auto& [after, added] : added_passes_) {
+        if (!names.count(after)) {
+            if (!after.empty()) {
+                LOG_WARNING("StandardWorldGenerator: WARNING - No pass named " << after
+                            << "; running " << added.name << " last");
             }
-            std::cout << "Finished expanding " << region_type << " sources" << std::endl;
+            pipeline.push_back(added);
+        }
+    }
+    return pipeline;
+}
+
+void StandardWorldGenerator::AddPass(GenerationPass pass, const std::string& after) {
+    added_passes_.emplace_back(after, std::move(pass));
+}
+
+u64 StandardWorldGenerator::HashTypeTable() const {
+    Utils::Fnv1a hash;
+    hash.Add(static_cast<u64>(cells_.GetTypeCount()));
+    for (size_t type = 0; type < cells_.GetTypeCount(); ++type) {
+        const TypeRules& rules = type_rules_[type];
+        hash.Add(cells_.GetTypeName(static_cast<TypeID>(type))).Add(rules.prevent_overwrite);
+        hash.Add(static_cast<u64>(rules.compatible.size()));
+        hash.AddBytes(rules.compatible.data(), rules.compatible.size());
+        hash.Add(static_cast<u64>(rules.incompatible.size()));
+        hash.AddBytes(rules.incompatible.data(), rules.incompatible.size());
+    }
+    return hash.Get();
+}
+
+void StandardWorldGenerator::ResetLayoutState() {
+    desert_hemisphere_set_ = false;
+    desert_northern_hemisphere_ = false;
+    forest_hemisphere_set_ = false;
+    forest_northern_hemisphere_ = false;
+    coastal_borders_.clear();
+}
+
+std::vector<u8> StandardWorldGenerator::SaveLayoutState() const {
+    u8 borders = 0;
+    for (u8 i = 0; i < 4; ++i) {
+        if (coastal_borders_.count(BORDER_NAMES[i])) {
+            borders |= static_cast<u8>(1u << i);
         }
     }
+    u8 hemispheres = static_cast<u8>(desert_hemisphere_set_ | desert_northern_hemisphere_ << 1 |
+                                     forest_hemisphere_set_ << 2 | forest_northern_hemisphere_ << 3);
+    return {borders, hemispheres};
+}
+
+void StandardWorldGenerator::RestoreLayoutState(std::span<const u8> state) {
+    ResetLayoutState();
+    u8 borders = state.size() > 0 ? state[0] : 0;
+    u8 hemispheres = state.size() > 1 ? state[1] : 0;
+    for (u8 i = 0; i < 4; ++i) {
+        if (borders & (1u << i)) {
+            coastal_borders_.insert(BORDER_NAMES[i]);
+        }
+    }
+    desert_hemisphere_set_ = hemispheres & 1;
+    desert_northern_hemisphere_ = hemispheres & 2;
+    forest_hemisphere_set_ = hemispheres & 4;
+    forest_northern_hemisphere_ = hemispheres & 8;
+}
+
+void StandardWorldGenerator::BeginPass(const std::string& name) {
+    PassReport pass;
+    pass.name = name;
+    report_.passes.push_back(pass);
+    pass_start_time_ = std::chrono::steady_clock::now();
+    pass_start_changes_ = cells_.GetChangeCount();
+}
+
+void StandardWorldGenerator::EndPass() {
+    PassReport& pass = CurrentPass();
+    pass.wall_time_ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - pass_start_time_).count();
+    pass.cells_changed += cells_.GetChangeCount() - pass_start_changes_;
+    
+    LOG_INFO("StandardWorldGenerator: Pass " << pass.name << ": " << pass.wall_time_ms << " ms, "
+             << pass.cells_changed << " cells changed, " << pass.attempts << " attempts, "
+             << pass.rejections << " rejected"
+             << (pass.expansions_cut_short > 0
+                     ? ", " + std::to_string(pass.expansions_cut_short) + " expansions cut short"
+                     : std::string()));
+}
+
+void StandardWorldGenerator::BuildTypeTable(
+    const std::unordered_map<std::string, RegionDefinition>& region_definitions) {
     
-    // Special passes for regions that don't follow standard source/expand pattern
-    Pass_Rivers(world.get(), region_definitions);
-    Pass_Settlements(world.get(), region_definitions);
-    Pass_Roads(world.get(), region_definitions);
+    static const char* const builtin_names[BUILTIN_TYPE_COUNT] = {
+        "Plains", "Coastal", "Mountain", "Forest", "Desert", "Water",
+        "River", "RiverSource", "Urban", "Rural", "Road"
+    };
     
-    std::cout << "\nStandardWorldGenerator: World generation complete" << std::endl;
-    std::cout << "StandardWorldGenerator: Created " << world->GetRegions().size() << " regions" << std::endl;
-    std::cout << "StandardWorldGenerator: Created " << world->GetSourceRegions().size() << " source regions" << std::endl;
-    std::cout << "StandardWorldGenerator: Created " << world->GetSettlements().size() << " settlements" << std::endl;
-    std::cout << "StandardWorldGenerator: Created " << world->GetRoads().size() << " roads" << std::endl;
+    cells_.ClearTypes();
+    for (const char* name : builtin_names) {
+        cells_.InternType(name);
+    }
+    for (const auto& [type, def] : region_definitions) {
+        cells_.InternType(type);
+        for (const auto& neighbor : def.compatible_neighbors) {
+            cells_.InternType(neighbor);
+        }
+        for (const auto& neighbor : def.incompatible_neighbors) {
+            cells_.InternType(neighbor);
+        }
+    }
     
-    return world;
+    type_rules_.assign(cells_.GetTypeCount(), TypeRules{});
+    for (const auto& [type, def] : region_definitions) {
+        TypeRules& rules = type_rules_[cells_.FindType(type)];
+        rules.prevent_overwrite = def.prevent_overwrite;
+        for (const auto& neighbor : def.compatible_neighbors) {
+            rules.compatible.push_back(cells_.FindType(neighbor));
+        }
+        for (const auto& neighbor : def.incompatible_neighbors) {
+            rules.incompatible.push_back(cells_.FindType(neighbor));
+        }
+    }
 }
 
-void StandardWorldGenerator::Pass0_InitializePlains(World* world) {
-    std::cout << "Pass 0: Initializing plains..." << std::endl;
-    
+void StandardWorldGenerator::Pass0_InitializePlains() {
     u32 total_regions = static_cast<u32>(grid_width_) * static_cast<u32>(grid_height_);
+    cells_.Reset(grid_width_, grid_height_, TYPE_PLAINS);
+    CurrentPass().cells_changed += total_regions;  // Reset is not a logged retype
+    
+    LOG_DEBUG("Pass 0: Initialized " << total_regions << " plains regions");
+}
+
+void StandardWorldGenerator::MaterializeRegions(World* world) {
+    u32 total_regions = cells_.GetCellCount();
     auto& regions = world->GetRegions();
     regions.clear();
     regions.reserve(total_regions);
     
-    // Initialize all regions as Plains
     for (u32 i = 0; i < total_regions; ++i) {
-        u16 x = static_cast<u16>(i % grid_width_);
-        u16 y = static_cast<u16>(i / grid_width_);
-        f32 world_x = static_cast<f32>(x) * region_size_;
-        f32 world_y = static_cast<f32>(y) * region_size_;
+        f32 world_x = static_cast<f32>(cells_.GetCellX(i)) * region_size_;
+        f32 world_y = static_cast<f32>(cells_.GetCellY(i)) * region_size_;
         
-        auto region = std::make_unique<Region>(i, "Plains");
+        auto region = std::make_unique<Region>(i, cells_.GetTypeName(cells_.GetTypeAt(i)));
         region->SetPosition(world_x, world_y);
+        if (cells_.IsSource(i)) {
+            region->SetIsSource(true);
+            region->SetName(cells_.GetName(i));
+        }
+        region->SetSourceParentID(cells_.GetSourceParent(i));
         region->Initialize();
         regions.push_back(std::move(region));
     }
-    
-    std::cout << "Pass 0: Initialized " << total_regions << " plains regions" << std::endl;
 }
 
 std::vector<std::string> StandardWorldGenerator::DetermineGenerationOrder(
@@ -171,319 +567,233 @@ std::vector<RegionID> StandardWorldGenerator::Pass_CreateSources(
     
     std::vector<RegionID> created_sources;
     
-    std::cout << "Creating source regions for type: " << region_type << std::endl;
+    LOG_DEBUG("Creating source regions for type: " << region_type);
+    
+    TypeID type = cells_.FindType(region_type);
     
     // Use values from region definition
-    u32 source_count = random_->RandomU32(def.min_source_count, def.max_source_count + 1);
+    u32 source_count = random_.RandomU32(def.min_source_count, def.max_source_count);
     
     // Special handling for Desert/Forest: keep them in opposite hemispheres
     if (region_type == "Desert" && !desert_hemisphere_set_) {
         if (forest_hemisphere_set_) {
             desert_northern_hemisphere_ = !forest_northern_hemisphere_;
         } else {
-            desert_northern_hemisphere_ = random_->RandomBool(0.5f);
+            desert_northern_hemisphere_ = random_.RandomBool(0.5f);
         }
         desert_hemisphere_set_ = true;
-        std::cout << "  Desert will be placed in " << (desert_northern_hemisphere_ ? "Northern" : "Southern") << " hemisphere" << std::endl;
+        LOG_DEBUG("  Desert will be placed in " << (desert_northern_hemisphere_ ? "Northern" : "Southern") << " hemisphere");
     } else if (region_type == "Forest" && !forest_hemisphere_set_) {
         if (desert_hemisphere_set_) {
             forest_northern_hemisphere_ = !desert_northern_hemisphere_;
         } else {
-            forest_northern_hemisphere_ = random_->RandomBool(0.5f);
+            forest_northern_hemisphere_ = random_.RandomBool(0.5f);
         }
         forest_hemisphere_set_ = true;
-        std::cout << "  Forest will be placed in " << (forest_northern_hemisphere_ ? "Northern" : "Southern") << " hemisphere" << std::endl;
+        LOG_DEBUG("  Forest will be placed in " << (forest_northern_hemisphere_ ? "Northern" : "Southern") << " hemisphere");
     }
     
-    u32 placed = 0;
-    u32 attempts = 0;
-    const u32 max_attempts = source_count * 200;
+    // Desert and Forest sources stay in their hemisphere's rows
+    u16 first_row = 0;
+    u16 end_row = grid_height_;
+    u16 equator = grid_height_ / 2;  // First southern row
+    if (region_type == "Desert" && desert_hemisphere_set_) {
+        first_row = desert_northern_hemisphere_ ? 0 : equator;
+        end_row = desert_northern_hemisphere_ ? equator : grid_height_;
+    } else if (region_type == "Forest" && forest_hemisphere_set_) {
+        first_row = forest_northern_hemisphere_ ? 0 : equator;
+        end_row = forest_northern_hemisphere_ ? equator : grid_height_;
+    }
     
-    while (placed < source_count && attempts < max_attempts) {
-        attempts++;
-        
-        // Find a suitable location
-        u16 x = static_cast<u16>(random_->RandomU32(0, grid_width_));
-        u16 y = static_cast<u16>(random_->RandomU32(0, grid_height_));
-        
-        // Special handling for Desert - must be in selected hemisphere
-        if (region_type == "Desert" && desert_hemisphere_set_) {
-            bool in_northern = IsInNorthernHemisphere(y);
-            if (in_northern != desert_northern_hemisphere_) {
-                continue;
-            }
-        }
-        
-        // Special handling for Forest - must be in selected hemisphere
-        if (region_type == "Forest" && forest_hemisphere_set_) {
-            bool in_northern = IsInNorthernHemisphere(y);
-            if (in_northern != forest_northern_hemisphere_) {
-                continue;
+    // Draw each source uniformly from the cells the type may occupy right now
+    u32 placed = 0;
+    if (type != CellGrid::INVALID_TYPE) {
+        const PlacementMask& mask = placement_masks_[type];
+        while (placed < source_count) {
+            SyncPlacementMasks();
+            u32 candidates = mask.CountRows(first_row, end_row);
+            if (candidates == 0) {
+                break;
             }
+            RegionID id = mask.FindNth(first_row, end_row, random_.RandomU32(0, candidates - 1));
+            
+            // Create source region
+            cells_.SetSource(id, type, GetRandomName(def));
+            
+            world->AddSourceRegion(id);
+            created_sources.push_back(id);
+            placed++;
         }
-        
-        // Check if we can place here
-        if (!CanPlaceRegion(world, x, y, def)) {
-            continue;
-        }
-        
-        Region* region = GetRegionAtGrid(world, x, y);
-        if (!region) {
-            continue;
-        }
-        
-        // Create source region
-        RegionID id = region->GetID();
-        f32 wx = region->GetX();
-        f32 wy = region->GetY();
-        auto& regions = world->GetRegions();
-        
-        regions[id] = std::make_unique<Region>(id, region_type);
-        regions[id]->SetPosition(wx, wy);
-        regions[id]->SetIsSource(true);
-        regions[id]->SetName(GetRandomName(def));
-        regions[id]->Initialize();
-        
-        world->AddSourceRegion(id);
-        created_sources.push_back(id);
-        placed++;
     }
     
-    std::cout << "  Created " << placed << "/" << source_count << " source regions for type: " << region_type << std::endl;
+    CurrentPass().attempts += source_count;
+    CurrentPass().rejections += source_count - placed;
+    LOG_DEBUG("  Created " << placed << "/" << source_count << " source regions for type: " << region_type);
     
     return created_sources;
 }
 
-void StandardWorldGenerator::Pass_ExpandFromSource(
-    World* world, 
+void StandardWorldGenerator::ExpandSources(const std::vector<RegionID>& sources, const RegionDefinition& def) {
+    TypeID type = cells_.FindType(def.type);
+    u64 type_key = Utils::RandomStream::DeriveKey(seed_, STREAM_EXPANSION, HashTypeName(def.type));
+    if (expansion_claims_.size() < sources.size()) {
+        expansion_claims_.resize(sources.size());
+    }
+    expansion_complete_.assign(sources.size(), 1);
+    
+    // Every source expands against the grid as it was when the pass began
+    // (masks synced here, so CanPlaceRegion only reads during the parallel part)
+    SyncPlacementMasks();
+    Utils::JobSystem::GetInstance().ParallelFor(static_cast<u32>(sources.size()), [&](u32 i) {
+        Utils::RandomStream random(type_key, 0, sources[i]);
+        expansion_claims_[i].clear();
+        expansion_complete_[i] = Pass_ExpandFromSource(sources[i], def, random, expansion_claims_[i]);
+    });
+    
+    // Merge in source order: a cell claimed by several sources ends up with
+    // the last of them, as if the sources had expanded one after another
+    for (size_t i = 0; i < sources.size(); ++i) {
+        for (u32 cell : expansion_claims_[i]) {
+            cells_.SetCell(cell, type, sources[i]);
+        }
+    }
+    
+    // One summary instead of a line per source; the report keeps the count
+    u32 cut_short = static_cast<u32>(std::count(expansion_complete_.begin(), expansion_complete_.end(), 0));
+    CurrentPass().expansions_cut_short += cut_short;
+    if (cut_short > 0) {
+        LOG_DEBUG(cut_short << "/" << sources.size() << " " << def.type
+                  << " expansions stopped early (no eligible cells left)");
+    }
+}
+
+bool StandardWorldGenerator::Pass_ExpandFromSource(
     RegionID source_id, 
-    const RegionDefinition& def) {
+    const RegionDefinition& def,
+    Utils::RandomStream& random,
+    std::vector<u32>& claims) {
     
-    Region* source_region = world->GetRegion(source_id);
-    if (!source_region || !source_region->IsSource()) {
-        return;
+    if (source_id >= cells_.GetCellCount() || !cells_.IsSource(source_id)) {
+        return true;
     }
     
-    u16 source_x, source_y;
-    {
-        const Region* const_source = source_region;
-        f32 world_x = const_source->GetX();
-        f32 world_y = const_source->GetY();
-        source_x = static_cast<u16>(world_x / region_size_);
-        source_y = static_cast<u16>(world_y / region_size_);
-    }
+    u16 source_x = cells_.GetCellX(source_id);
+    u16 source_y = cells_.GetCellY(source_id);
     
     // Special handling for coastal regions: expand inland from border
     if (def.type == "Coastal" && IsOnRim(source_x, source_y)) {
-        ExpandCoastalInland(world, source_id, def, source_x, source_y);
-    } else {
-        // Standard expansion for other region types
-        ExpandStandardRegion(world, source_id, def, source_x, source_y);
+        return ExpandCoastalInland(def, source_x, source_y, random, claims);
     }
+    // Standard expansion for other region types
+    return ExpandStandardRegion(def, source_x, source_y, random, claims);
 }
 
-void StandardWorldGenerator::ExpandCoastalInland(
-    World* world,
-    RegionID source_id,
+bool StandardWorldGenerator::ExpandCoastalInland(
     const RegionDefinition& def,
     u16 source_x,
-    u16 source_y) {
+    u16 source_y,
+    Utils::RandomStream& random,
+    std::vector<u32>& claims) {
     
     // Determine expansion amount (random within min/max)
-    u32 target_size = random_->RandomU32(def.min_expansion_size, def.max_expansion_size + 1);
+    u32 target_size = random.RandomU32(def.min_expansion_size, def.max_expansion_size);
     
-    u32 placed = 0;
-    std::vector<std::pair<u16, u16>> placed_cells;
-    std::unordered_set<u32> visited;
-    placed_cells.push_back({source_x, source_y});
-    visited.insert(static_cast<u32>(source_y) * static_cast<u32>(grid_width_) + static_cast<u32>(source_x));
-    
-    const u32 max_iterations = target_size * 100;
-    u32 iterations = 0;
+    ExpansionScratch& scratch = expansion_scratch_;
+    scratch.Begin(cells_.GetCellCount());
+    u32 source = cells_.GetCell(source_x, source_y);
+    scratch.MarkSeen(source);
+    DiscoverNeighbors(scratch, source, TYPE_COASTAL);
     
     f32 base_expand_prob = 0.4f;
     f32 expand_prob = base_expand_prob * def.expansion_weight;
     expand_prob = std::min(1.0f, expand_prob);
     
-    while (!placed_cells.empty() && placed < target_size && iterations < max_iterations) {
-        iterations++;
-        
-        u32 seed_idx = random_->RandomU32(0, static_cast<u32>(placed_cells.size()));
-        std::pair<u16, u16> current = placed_cells[seed_idx];
-        
-        std::vector<std::pair<u16, u16>> candidates;
-        
+    // Draw frontier cells and accept each with a probability that favours the
+    // border and existing coast; after 10 rejections in a row the drawn cell
+    // is taken anyway, so every claim costs at most 10 draws
+    u32 placed = 0;
+    u32 rejections = 0;
+    while (placed < target_size && !scratch.frontier.empty()) {
+        u32 index = random.RandomU32(0, static_cast<u32>(scratch.frontier.size()) - 1);
+        u32 cell = scratch.frontier[index];
+        u16 x = cells_.GetCellX(cell);
+        u16 y = cells_.GetCellY(cell);
+        
+        // Distance-based probability (closer to border = higher chance)
+        u16 border_distance = std::min({
+            y,
+            static_cast<u16>(grid_height_ - 1 - y),
+            x,
+            static_cast<u16>(grid_width_ - 1 - x)
+        });
+        
+        // Probability decreases with distance from border
+        f32 distance_factor = 1.0f - (static_cast<f32>(border_distance) / static_cast<f32>(target_size + 5));
+        distance_factor = std::max(0.1f, distance_factor);
+        
+        // Count coastal neighbors (own claims are not in the grid yet)
+        u32 coastal_neighbor_count = 0;
         for (i16 dy = -1; dy <= 1; ++dy) {
             for (i16 dx = -1; dx <= 1; ++dx) {
                 if (dx == 0 && dy == 0) continue;
-                
-                i16 nx = static_cast<i16>(current.first) + dx;
-                i16 ny = static_cast<i16>(current.second) + dy;
-                
+                i16 nx = static_cast<i16>(x) + dx;
+                i16 ny = static_cast<i16>(y) + dy;
                 if (nx < 0 || nx >= static_cast<i16>(grid_width_) ||
                     ny < 0 || ny >= static_cast<i16>(grid_height_)) {
                     continue;
                 }
-                
-                u16 gx = static_cast<u16>(nx);
-                u16 gy = static_cast<u16>(ny);
-                u32 pos_key = static_cast<u32>(gy) * static_cast<u32>(grid_width_) + static_cast<u32>(gx);
-                
-                if (visited.find(pos_key) != visited.end()) {
-                    continue;
-                }
-                
-                // Don't expand to other borders
-                if (IsOnRim(gx, gy)) {
-                    continue;
-                }
-                
-                Region* region = GetRegionAtGrid(world, gx, gy);
-                if (!region) {
-                    continue;
+                u32 neighbor = cells_.GetCell(static_cast<u16>(nx), static_cast<u16>(ny));
+                if (cells_.GetTypeAt(neighbor) == TYPE_COASTAL || scratch.IsClaimed(neighbor)) {
+                    ++coastal_neighbor_count;
                 }
-                
-                if (region->GetType() != "Plains" && region->GetType() != "Coastal") {
-                    continue;
-                }
-                
-                if (!CanPlaceRegion(world, gx, gy, def)) {
-                    continue;
-                }
-                
-                candidates.push_back({gx, gy});
             }
         }
         
-        for (const auto& candidate : candidates) {
-            if (placed >= target_size) {
-                break;
-            }
-            
-            u32 pos_key = static_cast<u32>(candidate.second) * static_cast<u32>(grid_width_) + static_cast<u32>(candidate.first);
-            if (visited.find(pos_key) != visited.end()) {
-                continue;
-            }
-            
-            // Distance-based probability (closer to border = higher chance)
-            u16 candidate_dist = std::min({
-                candidate.second,
-                static_cast<u16>(grid_height_ - 1 - candidate.second),
-                candidate.first,
-                static_cast<u16>(grid_width_ - 1 - candidate.first)
-            });
-            
-            // Probability decreases with distance from border
-            f32 distance_factor = 1.0f - (static_cast<f32>(candidate_dist) / static_cast<f32>(target_size + 5));
-            distance_factor = std::max(0.1f, distance_factor);
-            
-            // Count coastal neighbors
-            u32 coastal_neighbor_count = 0;
-            for (i16 ndy = -1; ndy <= 1; ++ndy) {
-                for (i16 ndx = -1; ndx <= 1; ++ndx) {
-                    if (ndx == 0 && ndy == 0) continue;
-                    i16 nnx = static_cast<i16>(candidate.first) + ndx;
-                    i16 nny = static_cast<i16>(candidate.second) + ndy;
-                    if (nnx < 0 || nnx >= static_cast<i16>(grid_width_) ||
-                        nny < 0 || nny >= static_cast<i16>(grid_height_)) {
-                        continue;
-                    }
-                    Region* n = GetRegionAtGrid(world, static_cast<u16>(nnx), static_cast<u16>(nny));
-                    if (n && n->GetType() == "Coastal") {
-                        ++coastal_neighbor_count;
-                    }
-                }
-            }
-            
-            f32 neighbor_boost = 1.0f + std::min<f32>(3.0f, 0.5f * static_cast<f32>(coastal_neighbor_count));
-            
-            f32 effective_weight = def.expansion_weight;
-            if (effective_weight < 0.3f) {
-                effective_weight = 0.3f;
-            }
-            
-            f32 final_expand_prob = expand_prob * distance_factor * neighbor_boost;
-            final_expand_prob = std::min(1.0f, final_expand_prob);
-            
-            if (random_->RandomFloat(0.0f, 1.0f) < final_expand_prob) {
-                Region* region = GetRegionAtGrid(world, candidate.first, candidate.second);
-                if (region) {
-                    RegionID id = region->GetID();
-                    f32 wx = region->GetX();
-                    f32 wy = region->GetY();
-                    auto& regions = world->GetRegions();
-                    
-                    regions[id] = std::make_unique<Region>(id, "Coastal");
-                    regions[id]->SetPosition(wx, wy);
-                    regions[id]->SetSourceParentID(source_id);
-                    regions[id]->Initialize();
-                    
-                    visited.insert(pos_key);
-                    placed_cells.push_back(candidate);
-                    placed++;
-                }
-            }
-        }
+        f32 neighbor_boost = 1.0f + std::min<f32>(3.0f, 0.5f * static_cast<f32>(coastal_neighbor_count));
+        f32 final_expand_prob = std::min(1.0f, expand_prob * distance_factor * neighbor_boost);
         
-        // Force expansion if stuck
-        if (placed == 0 && !candidates.empty() && iterations % 10 == 0) {
-            auto forced = candidates[random_->RandomU32(0, static_cast<u32>(candidates.size()))];
-            u32 pos_key = static_cast<u32>(forced.second) * static_cast<u32>(grid_width_) + static_cast<u32>(forced.first);
-            
-            if (visited.find(pos_key) == visited.end()) {
-                Region* region = GetRegionAtGrid(world, forced.first, forced.second);
-                if (region) {
-                    RegionID id = region->GetID();
-                    f32 wx = region->GetX();
-                    f32 wy = region->GetY();
-                    auto& regions = world->GetRegions();
-                    
-                    regions[id] = std::make_unique<Region>(id, "Coastal");
-                    regions[id]->SetPosition(wx, wy);
-                    regions[id]->SetSourceParentID(source_id);
-                    regions[id]->Initialize();
-                    
-                    visited.insert(pos_key);
-                    placed_cells.push_back(forced);
-                    placed++;
-                }
-            }
+        if (random.RandomFloat(0.0f, 1.0f) >= final_expand_prob && ++rejections < 10) {
+            continue;
         }
+        
+        rejections = 0;
+        scratch.TakeFrontier(index);
+        scratch.MarkClaimed(cell);
+        claims.push_back(cell);
+        placed++;
+        DiscoverNeighbors(scratch, cell, TYPE_COASTAL);
     }
+    scratch.End();
     
-    if (placed < target_size && iterations >= max_iterations) {
-        std::cout << "Warning: Coastal expansion for source " << source_id << " stopped early. Placed " 
-                  << placed << "/" << target_size << " regions after " << iterations << " iterations" << std::endl;
-    }
+    return placed >= target_size;
 }
 
 void StandardWorldGenerator::Pass_Coastal(World* world, const RegionDefinition& def) {
-    std::cout << "\n=== Pass: Coastal ===" << std::endl;
+    LOG_DEBUG("=== Pass: Coastal ===");
     
     // Step 1: Randomly select 0-4 borders to be coasts
     std::vector<std::string> all_borders = {"top", "bottom", "left", "right"};
     std::vector<std::string> selected_borders;
     
-    u32 border_count = random_->RandomU32(0, 4);  // 0-4 borders
+    u32 border_count = random_.RandomU32(0, 4);  // 0-4 borders
     std::vector<std::string> available_borders = all_borders;
     
     for (u32 i = 0; i < border_count && !available_borders.empty(); ++i) {
-        // RandomU32 is inclusive [min, max], so we need size-1 to avoid out-of-bounds
-        u32 size = static_cast<u32>(available_borders.size());
+            u32 size = static_cast<u32>(available_borders.size());
         if (size == 0) break;  // Safety check (shouldn't happen due to loop condition)
-        u32 idx = random_->RandomU32(0, size - 1);
+        u32 idx = random_.RandomU32(0, size - 1);
         selected_borders.push_back(available_borders[idx]);
         available_borders.erase(available_borders.begin() + idx);
     }
     
-    std::cout << "Selected " << selected_borders.size() << " border(s) for coastal generation: ";
+    std::string border_list;
     for (const auto& border : selected_borders) {
-        std::cout << border << " ";
+        border_list += border + " ";
     }
-    std::cout << std::endl;
+    LOG_DEBUG("Selected " << selected_borders.size() << " border(s) for coastal generation: " << border_list);
     
     if (selected_borders.empty()) {
-        std::cout << "No borders selected for coastal generation" << std::endl;
+        LOG_DEBUG("No borders selected for coastal generation");
         return;
     }
     
@@ -491,6 +801,7 @@ void StandardWorldGenerator::Pass_Coastal(World* world, const RegionDefinition&
     for (const auto& border : selected_borders) {
         coastal_borders_.insert(border);
     }
+    BuildPlacementMasks();  // Other types may no longer occupy these borders
     
     // Step 2: Convert all regions along selected borders to Coastal (all as sources)
     std::vector<RegionID> source_regions;
@@ -498,18 +809,9 @@ void StandardWorldGenerator::Pass_Coastal(World* world, const RegionDefinition&
     for (const auto& border : selected_borders) {
         if (border == "top") {
             for (u16 x = 0; x < grid_width_; ++x) {
-                Region* region = GetRegionAtGrid(world, x, 0);
-                if (region && CanPlaceRegion(world, x, 0, def)) {
-                    RegionID id = region->GetID();
-                    f32 wx = region->GetX();
-                    f32 wy = region->GetY();
-                    auto& regions = world->GetRegions();
-                    
-                    regions[id] = std::make_unique<Region>(id, "Coastal");
-                    regions[id]->SetPosition(wx, wy);
-                    regions[id]->SetIsSource(true);
-                    regions[id]->SetName(GetRandomName(def));
-                    regions[id]->Initialize();
+                if (CanPlaceRegion(x, 0, TYPE_COASTAL)) {
+                    RegionID id = cells_.GetCell(x, 0);
+                    cells_.SetSource(id, TYPE_COASTAL, GetRandomName(def));
                     
                     world->AddSourceRegion(id);
                     source_regions.push_back(id);
@@ -517,18 +819,9 @@ void StandardWorldGenerator::Pass_Coastal(World* world, const RegionDefinition&
             }
         } else if (border == "bottom") {
             for (u16 x = 0; x < grid_width_; ++x) {
-                Region* region = GetRegionAtGrid(world, x, grid_height_ - 1);
-                if (region && CanPlaceRegion(world, x, grid_height_ - 1, def)) {
-                    RegionID id = region->GetID();
-                    f32 wx = region->GetX();
-                    f32 wy = region->GetY();
-                    auto& regions = world->GetRegions();
-                    
-                    regions[id] = std::make_unique<Region>(id, "Coastal");
-                    regions[id]->SetPosition(wx, wy);
-                    regions[id]->SetIsSource(true);
-                    regions[id]->SetName(GetRandomName(def));
-                    regions[id]->Initialize();
+                if (CanPlaceRegion(x, grid_height_ - 1, TYPE_COASTAL)) {
+                    RegionID id = cells_.GetCell(x, grid_height_ - 1);
+                    cells_.SetSource(id, TYPE_COASTAL, GetRandomName(def));
                     
                     world->AddSourceRegion(id);
                     source_regions.push_back(id);
@@ -536,18 +829,9 @@ void StandardWorldGenerator::Pass_Coastal(World* world, const RegionDefinition&
             }
         } else if (border == "left") {
             for (u16 y = 0; y < grid_height_; ++y) {
-                Region* region = GetRegionAtGrid(world, 0, y);
-                if (region && CanPlaceRegion(world, 0, y, def)) {
-                    RegionID id = region->GetID();
-                    f32 wx = region->GetX();
-                    f32 wy = region->GetY();
-                    auto& regions = world->GetRegions();
-                    
-                    regions[id] = std::make_unique<Region>(id, "Coastal");
-                    regions[id]->SetPosition(wx, wy);
-                    regions[id]->SetIsSource(true);
-                    regions[id]->SetName(GetRandomName(def));
-                    regions[id]->Initialize();
+                if (CanPlaceRegion(0, y, TYPE_COASTAL)) {
+                    RegionID id = cells_.GetCell(0, y);
+                    cells_.SetSource(id, TYPE_COASTAL, GetRandomName(def));
                     
                     world->AddSourceRegion(id);
                     source_regions.push_back(id);
@@ -555,18 +839,9 @@ void StandardWorldGenerator::Pass_Coastal(World* world, const RegionDefinition&
             }
         } else if (border == "right") {
             for (u16 y = 0; y < grid_height_; ++y) {
-                Region* region = GetRegionAtGrid(world, grid_width_ - 1, y);
-                if (region && CanPlaceRegion(world, grid_width_ - 1, y, def)) {
-                    RegionID id = region->GetID();
-                    f32 wx = region->GetX();
-                    f32 wy = region->GetY();
-                    auto& regions = world->GetRegions();
-                    
-                    regions[id] = std::make_unique<Region>(id, "Coastal");
-                    regions[id]->SetPosition(wx, wy);
-                    regions[id]->SetIsSource(true);
-                    regions[id]->SetName(GetRandomName(def));
-                    regions[id]->Initialize();
+                if (CanPlaceRegion(grid_width_ - 1, y, TYPE_COASTAL)) {
+                    RegionID id = cells_.GetCell(grid_width_ - 1, y);
+                    cells_.SetSource(id, TYPE_COASTAL, GetRandomName(def));
                     
                     world->AddSourceRegion(id);
                     source_regions.push_back(id);
@@ -575,53 +850,33 @@ void StandardWorldGenerator::Pass_Coastal(World* world, const RegionDefinition&
         }
     }
     
-    std::cout << "Converted " << source_regions.size() << " border cells to Coastal (all as sources)" << std::endl;
+    u64 border_cells = 0;
+    for (const auto& border : selected_borders) {
+        border_cells += (border == "top" || border == "bottom") ? grid_width_ : grid_height_;
+    }
+    CurrentPass().attempts += border_cells;
+    CurrentPass().rejections += border_cells - source_regions.size();
+    LOG_DEBUG("Converted " << source_regions.size() << " border cells to Coastal (all as sources)");
     
     // Step 3: Expand from each source independently
     if (def.max_expansion_size > 0 && !source_regions.empty()) {
-        std::cout << "Expanding " << source_regions.size() << " coastal sources inland..." << std::endl;
-        
-        for (RegionID source_id : source_regions) {
-            Pass_ExpandFromSource(world, source_id, def);
-        }
+        LOG_DEBUG("Expanding " << source_regions.size() << " coastal sources inland...");
         
-        std::cout << "Finished expanding coastal sources" << std::endl;
+        ExpandSources(source_regions, def);
     }
 }
 
-void StandardWorldGenerator::ExpandStandardRegion(
-    World* world,
-    RegionID source_id,
+bool StandardWorldGenerator::ExpandStandardRegion(
     const RegionDefinition& def,
     u16 source_x,
-    u16 source_y) {
-    
-    Region* source_region = world->GetRegion(source_id);
-    if (!source_region) {
-        return;
-    }
+    u16 source_y,
+    Utils::RandomStream& random,
+    std::vector<u32>& claims) {
     
-    // Special handling for Desert/Forest: determine hemisphere from first source
-    bool source_in_northern = IsInNorthernHemisphere(source_y);
-    if (def.type == "Desert") {
-        if (!desert_hemisphere_set_) {
-            desert_northern_hemisphere_ = source_in_northern;
-            desert_hemisphere_set_ = true;
-        }
-        if (forest_hemisphere_set_) {
-            forest_northern_hemisphere_ = !desert_northern_hemisphere_;
-        }
-    } else if (def.type == "Forest") {
-        if (!forest_hemisphere_set_) {
-            forest_northern_hemisphere_ = source_in_northern;
-            forest_hemisphere_set_ = true;
-        }
-        if (desert_hemisphere_set_) {
-            desert_northern_hemisphere_ = !forest_northern_hemisphere_;
-        }
-    }
+    // Desert/Forest hemispheres are fixed by Pass_CreateSources
+    TypeID type = cells_.FindType(def.type);
     
-    u32 target_size = random_->RandomU32(def.min_expansion_size, def.max_expansion_size + 1);
+    u32 target_size = random.RandomU32(def.min_expansion_size, def.max_expansion_size);
     
     // Cap expansion size to prevent exceeding grid capacity
     u32 max_grid_cells = static_cast<u32>(grid_width_) * static_cast<u32>(grid_height_);
@@ -630,196 +885,98 @@ void StandardWorldGenerator::ExpandStandardRegion(
         target_size = max_expansion;
     }
     
-    u32 placed = 0;
-    
-    std::vector<std::pair<u16, u16>> placed_cells;
-    std::unordered_set<u32> visited;
-    placed_cells.push_back({source_x, source_y});
-    visited.insert(static_cast<u32>(source_y) * static_cast<u32>(grid_width_) + static_cast<u32>(source_x));
+    ExpansionScratch& scratch = expansion_scratch_;
+    scratch.Begin(cells_.GetCellCount());
+    u32 source = cells_.GetCell(source_x, source_y);
+    scratch.MarkSeen(source);
+    DiscoverNeighbors(scratch, source, type);
     
-    const u32 max_iterations = target_size * 100;
-    u32 iterations = 0;
-    
-    f32 base_expand_prob = 0.3f;
-    f32 expand_prob = base_expand_prob * def.expansion_weight;
-    expand_prob = std::min(1.0f, expand_prob);
+    // Grow by claiming a uniformly random frontier cell at a time
+    u32 placed = 0;
+    while (placed < target_size && !scratch.frontier.empty()) {
+        u32 index = random.RandomU32(0, static_cast<u32>(scratch.frontier.size()) - 1);
+        u32 cell = scratch.TakeFrontier(index);
+        scratch.MarkClaimed(cell);
+        claims.push_back(cell);
+        placed++;
+        DiscoverNeighbors(scratch, cell, type);
+    }
+    scratch.End();
     
-    while (!placed_cells.empty() && placed < target_size && iterations < max_iterations) {
-        iterations++;
-        
-        u32 seed_idx = random_->RandomU32(0, static_cast<u32>(placed_cells.size()));
-        std::pair<u16, u16> current = placed_cells[seed_idx];
-        
-        bool expanded_this_iteration = false;
-        std::vector<std::pair<u16, u16>> candidates;
-        
-        for (i16 dy = -1; dy <= 1; ++dy) {
-            for (i16 dx = -1; dx <= 1; ++dx) {
-                if (dx == 0 && dy == 0) continue;
-                
-                i16 nx = static_cast<i16>(current.first) + dx;
-                i16 ny = static_cast<i16>(current.second) + dy;
-                
-                if (nx < 0 || nx >= static_cast<i16>(grid_width_) ||
-                    ny < 0 || ny >= static_cast<i16>(grid_height_)) {
-                    continue;
-                }
-                
-                u16 gx = static_cast<u16>(nx);
-                u16 gy = static_cast<u16>(ny);
-                u32 pos_key = static_cast<u32>(gy) * static_cast<u32>(grid_width_) + static_cast<u32>(gx);
-                
-                if (visited.find(pos_key) != visited.end()) {
-                    continue;
-                }
-                
-                // Special handling for Desert: must stay in hemisphere and avoid rivers
-                if (def.type == "Desert" && desert_hemisphere_set_) {
-                    bool in_northern = IsInNorthernHemisphere(gy);
-                    if (in_northern != desert_northern_hemisphere_) {
-                        continue;
-                    }
-                    
-                    Region* check_region = GetRegionAtGrid(world, gx, gy);
-                    if (check_region && check_region->GetType() == "River") {
-                        continue;
-                    }
-                    
-                    bool has_river_neighbor = false;
-                    for (i16 check_dy = -1; check_dy <= 1 && !has_river_neighbor; ++check_dy) {
-                        for (i16 check_dx = -1; check_dx <= 1 && !has_river_neighbor; ++check_dx) {
-                            if (check_dx == 0 && check_dy == 0) continue;
-                            i16 check_nx = static_cast<i16>(gx) + check_dx;
-                            i16 check_ny = static_cast<i16>(gy) + check_dy;
-                            if (check_nx >= 0 && check_nx < static_cast<i16>(grid_width_) &&
-                                check_ny >= 0 && check_ny < static_cast<i16>(grid_height_)) {
-                                Region* neighbor = GetRegionAtGrid(world, static_cast<u16>(check_nx), static_cast<u16>(check_ny));
-                                if (neighbor && neighbor->GetType() == "River") {
-                                    has_river_neighbor = true;
-                                }
-                            }
-                        }
-                    }
-                    if (has_river_neighbor) {
-                        continue;
-                    }
-                }
-                
-                // Special handling for Forest: must stay in its selected hemisphere
-                if (def.type == "Forest" && forest_hemisphere_set_) {
-                    bool in_northern_forest = IsInNorthernHemisphere(gy);
-                    if (in_northern_forest != forest_northern_hemisphere_) {
-                        continue;
-                    }
-                }
-                
-                Region* region = GetRegionAtGrid(world, gx, gy);
-                if (!region) {
-                    continue;
-                }
-                
-                bool can_expand_into = false;
-                if (region->GetType() == "Plains" || region->GetType() == def.type) {
-                    can_expand_into = true;
-                } else {
-                    for (const auto& compatible_type : def.compatible_neighbors) {
-                        if (region->GetType() == compatible_type) {
-                            can_expand_into = true;
-                            break;
-                        }
-                    }
-                }
-                
-                if (!can_expand_into) {
-                    continue;
-                }
-                
-                if (!CanPlaceRegion(world, gx, gy, def)) {
-                    continue;
-                }
-                
-                candidates.push_back({gx, gy});
-            }
-        }
-        
-        for (const auto& candidate : candidates) {
-            if (placed >= target_size) {
-                break;
-            }
+    return placed >= target_size;
+}
+
+void StandardWorldGenerator::DiscoverNeighbors(ExpansionScratch& scratch, u32 cell, TypeID type) {
+    u16 x = cells_.GetCellX(cell);
+    u16 y = cells_.GetCellY(cell);
+    for (i16 dy = -1; dy <= 1; ++dy) {
+        for (i16 dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dy == 0) continue;
             
-            u32 pos_key = static_cast<u32>(candidate.second) * static_cast<u32>(grid_width_) + static_cast<u32>(candidate.first);
-            if (visited.find(pos_key) != visited.end()) {
+            i16 nx = static_cast<i16>(x) + dx;
+            i16 ny = static_cast<i16>(y) + dy;
+            if (nx < 0 || nx >= static_cast<i16>(grid_width_) ||
+                ny < 0 || ny >= static_cast<i16>(grid_height_)) {
                 continue;
             }
             
-            if (random_->RandomFloat(0.0f, 1.0f) < expand_prob) {
-                Region* region = GetRegionAtGrid(world, candidate.first, candidate.second);
-                if (region) {
-                    RegionID id = region->GetID();
-                    f32 wx = region->GetX();
-                    f32 wy = region->GetY();
-                    auto& regions = world->GetRegions();
-                    
-                    regions[id] = std::make_unique<Region>(id, def.type);
-                    regions[id]->SetPosition(wx, wy);
-                    regions[id]->SetSourceParentID(source_id);
-                    regions[id]->Initialize();
-                    
-                    visited.insert(pos_key);
-                    placed_cells.push_back(candidate);
-                    placed++;
-                    expanded_this_iteration = true;
-                }
+            // The grid does not change during an expansion, so each cell is
+            // checked once and either queued or dropped for good
+            u32 neighbor = cells_.GetCell(static_cast<u16>(nx), static_cast<u16>(ny));
+            if (scratch.IsSeen(neighbor)) {
+                continue;
+            }
+            scratch.MarkSeen(neighbor);
+            if (CanExpandInto(static_cast<u16>(nx), static_cast<u16>(ny), type)) {
+                scratch.frontier.push_back(neighbor);
             }
         }
-        
-        if (!expanded_this_iteration && !candidates.empty() && iterations % 10 == 0) {
-            auto candidate = candidates[random_->RandomU32(0, static_cast<u32>(candidates.size()))];
-            u32 pos_key = static_cast<u32>(candidate.second) * static_cast<u32>(grid_width_) + static_cast<u32>(candidate.first);
-            
-            if (visited.find(pos_key) == visited.end()) {
-                Region* region = GetRegionAtGrid(world, candidate.first, candidate.second);
-                if (region) {
-                    // Special check for Desert: never overwrite rivers
-                    if (def.type == "Desert" && region->GetType() == "River") {
-                        continue;
-                    }
-                    
-                    RegionID id = region->GetID();
-                    f32 wx = region->GetX();
-                    f32 wy = region->GetY();
-                    auto& regions = world->GetRegions();
-                    
-                    regions[id] = std::make_unique<Region>(id, def.type);
-                    regions[id]->SetPosition(wx, wy);
-                    regions[id]->SetSourceParentID(source_id);
-                    regions[id]->Initialize();
-                    
-                    visited.insert(pos_key);
-                    placed_cells.push_back(candidate);
-                    placed++;
+    }
+}
+
+bool StandardWorldGenerator::CanExpandInto(u16 x, u16 y, TypeID type) {
+    // Coast grows inland over plains only, never along other borders
+    if (type == TYPE_COASTAL) {
+        return !IsOnRim(x, y) && cells_.GetType(x, y) == TYPE_PLAINS && CanPlaceRegion(x, y, TYPE_COASTAL);
+    }
+    
+    // Desert must stay in its hemisphere and away from rivers
+    if (type == TYPE_DESERT && desert_hemisphere_set_) {
+        if (IsInNorthernHemisphere(y) != desert_northern_hemisphere_) {
+            return false;
+        }
+        for (i16 dy = -1; dy <= 1; ++dy) {
+            for (i16 dx = -1; dx <= 1; ++dx) {
+                i16 nx = static_cast<i16>(x) + dx;
+                i16 ny = static_cast<i16>(y) + dy;
+                if (nx >= 0 && ny >= 0 &&
+                    cells_.GetType(static_cast<u16>(nx), static_cast<u16>(ny)) == TYPE_RIVER) {
+                    return false;
                 }
             }
         }
     }
     
-    if (placed < target_size && iterations >= max_iterations) {
-        std::cout << "Warning: Expansion for source " << source_id << " stopped early. Placed " 
-                  << placed << "/" << target_size << " regions after " << iterations << " iterations" << std::endl;
+    // Forest must stay in its selected hemisphere
+    if (type == TYPE_FOREST && forest_hemisphere_set_ &&
+        IsInNorthernHemisphere(y) != forest_northern_hemisphere_) {
+        return false;
     }
+    
+    return CanPlaceRegion(x, y, type);
 }
 
 void StandardWorldGenerator::Pass_Rivers(
     World* world,
     const std::unordered_map<std::string, RegionDefinition>& region_definitions) {
     
-    std::cout << "\n=== Pass: Rivers ===" << std::endl;
+    LOG_DEBUG("=== Pass: Rivers ===");
     
     auto river_source_it = region_definitions.find("RiverSource");
     auto river_it = region_definitions.find("River");
     
     if (river_source_it == region_definitions.end() || river_it == region_definitions.end()) {
-        std::cout << "Pass_Rivers: Skipped - River or RiverSource types not in config" << std::endl;
+        LOG_INFO("Pass_Rivers: Skipped - River or RiverSource types not in config");
         return;
     }
     
@@ -830,10 +987,12 @@ void StandardWorldGenerator::Pass_Rivers(
     std::vector<RegionID> river_sources = Pass_CreateRiverSources(world, river_source_def);
     
     // Step 2: Expand from each RiverSource to create River paths to coastal regions
+    // (rivers never create or remove Coastal cells, so one index serves the pass)
     if (!river_sources.empty()) {
-        std::cout << "Creating rivers from " << river_sources.size() << " sources..." << std::endl;
+        BuildFeatureIndex(coastal_index_, {TYPE_COASTAL});
+        LOG_DEBUG("Creating rivers from " << river_sources.size() << " sources...");
         for (RegionID source_id : river_sources) {
-            Pass_ExpandRiverFromSource(world, source_id, river_def);
+            Pass_ExpandRiverFromSource(source_id, river_def);
         }
     }
 }
@@ -848,214 +1007,136 @@ std::vector<RegionID> StandardWorldGenerator::Pass_CreateRiverSources(
     std::vector<std::pair<u16, u16>> candidates;
     for (u16 y = 0; y < grid_height_; ++y) {
         for (u16 x = 0; x < grid_width_; ++x) {
-            Region* region = GetRegionAtGrid(world, x, y);
-            if (!region || region->GetType() == "Mountain" || region->GetType() == "Water" || 
-                region->GetType() == "Coastal" || region->GetType() == "River" || region->GetType() == "RiverSource") {
+            TypeID cell_type = cells_.GetType(x, y);
+            if (cell_type == TYPE_MOUNTAIN || cell_type == TYPE_WATER || 
+                cell_type == TYPE_COASTAL || cell_type == TYPE_RIVER || cell_type == TYPE_RIVER_SOURCE) {
                 continue;
             }
             
             bool adjacent_to_mountain = false;
-            Region* neighbors[4] = {
-                GetRegionAtGrid(world, x, y - 1),
-                GetRegionAtGrid(world, x, y + 1),
-                GetRegionAtGrid(world, x - 1, y),
-                GetRegionAtGrid(world, x + 1, y)
+            TypeID neighbors[4] = {
+                cells_.GetType(x, y - 1),
+                cells_.GetType(x, y + 1),
+                cells_.GetType(x - 1, y),
+                cells_.GetType(x + 1, y)
             };
             
-            for (Region* neighbor : neighbors) {
-                if (neighbor && neighbor->GetType() == "Mountain") {
+            for (TypeID neighbor : neighbors) {
+                if (neighbor == TYPE_MOUNTAIN) {
                     adjacent_to_mountain = true;
                     break;
                 }
             }
             
-            if (adjacent_to_mountain && CanPlaceRegion(world, x, y, def)) {
+            if (adjacent_to_mountain && CanPlaceRegion(x, y, TYPE_RIVER_SOURCE)) {
                 candidates.push_back({x, y});
             }
         }
     }
     
     // Create 1-3 river sources
-    u32 source_count = random_->RandomU32(1, 4);
+    u32 source_count = random_.RandomU32(1, 3);
     source_count = std::min(source_count, static_cast<u32>(candidates.size()));
     
     // Shuffle candidates
     for (u32 i = 0; i < candidates.size() && created_sources.size() < source_count; ++i) {
-        u32 j = random_->RandomU32(i, static_cast<u32>(candidates.size()));
+        u32 j = random_.RandomU32(i, static_cast<u32>(candidates.size()) - 1);
         std::swap(candidates[i], candidates[j]);
         
         auto& pos = candidates[i];
-        if (random_->RandomFloat(0.0f, 1.0f) < 0.10f) {
-            Region* region = GetRegionAtGrid(world, pos.first, pos.second);
-            if (region) {
-                RegionID id = region->GetID();
-                f32 wx = region->GetX();
-                f32 wy = region->GetY();
-                auto& regions = world->GetRegions();
-                
-                regions[id] = std::make_unique<Region>(id, "RiverSource");
-                regions[id]->SetPosition(wx, wy);
-                regions[id]->SetIsSource(true);
-                regions[id]->SetName(GetRandomName(def));
-                regions[id]->Initialize();
-                
-                world->AddSourceRegion(id);
-                created_sources.push_back(id);
-            }
+        CurrentPass().attempts++;
+        if (random_.RandomFloat(0.0f, 1.0f) < 0.10f) {
+            RegionID id = cells_.GetCell(pos.first, pos.second);
+            cells_.SetSource(id, TYPE_RIVER_SOURCE, GetRandomName(def));
+            
+            world->AddSourceRegion(id);
+            created_sources.push_back(id);
+        } else {
+            CurrentPass().rejections++;
         }
     }
     
-    std::cout << "Created " << created_sources.size() << " river sources" << std::endl;
+    LOG_DEBUG("Created " << created_sources.size() << " river sources");
     
     return created_sources;
 }
 
 void StandardWorldGenerator::Pass_ExpandRiverFromSource(
-    World* world,
     RegionID source_id,
     const RegionDefinition& def) {
     (void)def;  // Parameter kept for consistency with other expansion functions
     
-    Region* source_region = world->GetRegion(source_id);
-    if (!source_region) {
+    if (source_id >= cells_.GetCellCount()) {
         return;
     }
     
-    f32 source_wx = source_region->GetX();
-    f32 source_wy = source_region->GetY();
-    u16 source_x = static_cast<u16>(source_wx / region_size_);
-    u16 source_y = static_cast<u16>(source_wy / region_size_);
+    u16 source_x = cells_.GetCellX(source_id);
+    u16 source_y = cells_.GetCellY(source_id);
     
-    // Find nearest coastal region
-    std::pair<u16, u16> nearest_destination;
-    bool found_destination = false;
-    f32 min_dist = std::numeric_limits<f32>::max();
-    
-    for (u16 cy = 0; cy < grid_height_; ++cy) {
-        for (u16 cx = 0; cx < grid_width_; ++cx) {
-            Region* region = GetRegionAtGrid(world, cx, cy);
-            if (region && region->GetType() == "Coastal") {
-                f32 dist = std::sqrt(
-                    std::pow(static_cast<f32>(source_x) - static_cast<f32>(cx), 2.0f) +
-                    std::pow(static_cast<f32>(source_y) - static_cast<f32>(cy), 2.0f)
-                );
-                if (dist < min_dist) {
-                    min_dist = dist;
-                    nearest_destination = {cx, cy};
-                    found_destination = true;
-                }
-            }
-        }
-    }
+    // Each river meanders on its own stream
+    random_ = Utils::RandomStream(seed_, STREAM_RIVERS, source_id);
     
-    // If no coastal regions found, find nearest border instead
-    if (!found_destination) {
-        std::cout << "No coastal regions found, finding nearest border for river source " << source_id << std::endl;
-        
-        // Find nearest border position
-        std::vector<std::pair<u16, u16>> border_positions;
-        
-        // Top border
-        for (u16 x = 0; x < grid_width_; ++x) {
-            border_positions.push_back({x, 0});
-        }
-        // Bottom border
-        for (u16 x = 0; x < grid_width_; ++x) {
-            border_positions.push_back({x, grid_height_ - 1});
-        }
-        // Left border
-        for (u16 y = 0; y < grid_height_; ++y) {
-            border_positions.push_back({0, y});
-        }
-        // Right border
-        for (u16 y = 0; y < grid_height_; ++y) {
-            border_positions.push_back({grid_width_ - 1, y});
-        }
-        
-        // Find nearest border position
-        for (const auto& border_pos : border_positions) {
-            f32 dist = std::sqrt(
-                std::pow(static_cast<f32>(source_x) - static_cast<f32>(border_pos.first), 2.0f) +
-                std::pow(static_cast<f32>(source_y) - static_cast<f32>(border_pos.second), 2.0f)
-            );
-            if (dist < min_dist) {
-                min_dist = dist;
-                nearest_destination = border_pos;
-                found_destination = true;
-            }
-        }
-    }
-    
-    if (!found_destination) {
-        std::cout << "Warning: Could not find destination for river source " << source_id << std::endl;
-        return;
+    // Find nearest coastal region (index built by Pass_Rivers)
+    std::pair<u16, u16> nearest_destination;
+    if (coastal_index_.HasSites()) {
+        nearest_destination = coastal_index_.GetNearestPosition(source_x, source_y);
+    } else {
+        // If no coastal regions found, find nearest border instead
+        LOG_DEBUG("No coastal regions found, finding nearest border for river source " << source_id);
+        nearest_destination = FindNearestBorder(source_x, source_y);
     }
     
     // Create river path with merging logic
-    std::vector<std::pair<u16, u16>> river_path = FindPathWithMerging(world, {source_x, source_y}, nearest_destination);
+    std::vector<std::pair<u16, u16>> river_path = FindPathWithMerging({source_x, source_y}, nearest_destination);
     
     // Place river regions along the path
     // Rivers can flow through most terrain types (except those that prevent overwrite)
     u32 river_count = 0;
     for (const auto& path_pos : river_path) {
-        Region* region = GetRegionAtGrid(world, path_pos.first, path_pos.second);
-        if (!region) {
+        TypeID cell_type = cells_.GetType(path_pos.first, path_pos.second);
+        if (cell_type == CellGrid::INVALID_TYPE) {
             continue;
         }
         
         // Skip certain region types that rivers cannot flow through
-        if (region->GetType() == "Water" || region->GetType() == "Coastal" || 
-            region->GetType() == "Mountain" || region->GetType() == "RiverSource") {
+        if (cell_type == TYPE_WATER || cell_type == TYPE_COASTAL || 
+            cell_type == TYPE_MOUNTAIN || cell_type == TYPE_RIVER_SOURCE) {
             continue;
         }
         
         // Check if this region has prevent_overwrite set
-        auto& config = Config::Configuration::GetInstance();
-        const auto& region_defs = config.regions.region_definitions;
-        auto existing_region_it = region_defs.find(region->GetType());
-        if (existing_region_it != region_defs.end() && existing_region_it->second.prevent_overwrite) {
+        if (type_rules_[cell_type].prevent_overwrite) {
             continue;  // Skip regions that prevent overwrite
         }
         
         // Rivers can flow through any other terrain (including Desert, Forest, Plains, etc.)
-        RegionID id = region->GetID();
-        f32 rx_world = region->GetX();
-        f32 ry_world = region->GetY();
-        auto& regions = world->GetRegions();
-        
-        // Preserve source info if it exists
-        bool was_source = region->IsSource();
-        std::string region_name = region->GetName();
-        RegionID parent_id = region->GetSourceParentID();
-        
-        regions[id] = std::make_unique<Region>(id, "River");
-        regions[id]->SetPosition(rx_world, ry_world);
-        regions[id]->SetSourceParentID(source_id);
-        if (was_source) {
-            regions[id]->SetIsSource(true);
-            regions[id]->SetName(region_name);
-        } else if (parent_id != INVALID_REGION_ID) {
+        u32 cell = cells_.GetCell(path_pos.first, path_pos.second);
+        if (cells_.IsSource(cell)) {
+            // Preserve source info if it exists
+            cells_.SetType(cell, TYPE_RIVER);
+            cells_.SetSourceParent(cell, source_id);
+        } else {
             // Keep the original parent if it exists
-            regions[id]->SetSourceParentID(parent_id);
+            RegionID parent_id = cells_.GetSourceParent(cell);
+            cells_.SetCell(cell, TYPE_RIVER, parent_id != INVALID_REGION_ID ? parent_id : source_id);
         }
-        regions[id]->Initialize();
         river_count++;
     }
     
-    std::cout << "Created " << river_count << " river regions from source " << source_id << std::endl;
+    LOG_DEBUG("Created " << river_count << " river regions from source " << source_id);
 }
 
 void StandardWorldGenerator::Pass_Settlements(
     World* world,
     const std::unordered_map<std::string, RegionDefinition>& region_definitions) {
     
-    std::cout << "\n=== Pass: Settlements ===" << std::endl;
+    LOG_DEBUG("=== Pass: Settlements ===");
     
     auto urban_it = region_definitions.find("Urban");
     auto rural_it = region_definitions.find("Rural");
     
     if (urban_it == region_definitions.end() || rural_it == region_definitions.end()) {
-        std::cout << "Pass_Settlements: Skipped - Urban or Rural types not in config" << std::endl;
+        LOG_INFO("Pass_Settlements: Skipped - Urban or Rural types not in config");
         return;
     }
     
@@ -1063,367 +1144,38 @@ void StandardWorldGenerator::Pass_Settlements(
     const RegionDefinition& rural_def = rural_it->second;
     
     std::vector<World::Settlement> settlements;
+    settlement_sampler_.Reset(grid_width_, grid_height_, SETTLEMENT_SPACING);
     
-    // Minimum distance between settlements (in grid cells)
-    const u16 min_settlement_distance = 12;
-    
-    // Helper function to check if a position is far enough from existing settlements
-    auto IsFarEnoughFromSettlements = [&](u16 x, u16 y) -> bool {
-        for (const auto& settlement : settlements) {
-            f32 dist = std::sqrt(
-                std::pow(static_cast<f32>(x) - static_cast<f32>(settlement.grid_x), 2.0f) +
-                std::pow(static_cast<f32>(y) - static_cast<f32>(settlement.grid_y), 2.0f)
-            );
-            if (dist < static_cast<f32>(min_settlement_distance)) {
-                return false;
-            }
-        }
-        return true;
-    };
-    
-    // Helper function to score a candidate (higher = better, prefers farther from existing settlements)
-    auto ScoreCandidate = [&](u16 x, u16 y) -> f32 {
-        if (settlements.empty()) {
-            return 1.0f;  // First settlement gets neutral score
-        }
-        
-        f32 min_dist = std::numeric_limits<f32>::max();
-        for (const auto& settlement : settlements) {
-            f32 dist = std::sqrt(
-                std::pow(static_cast<f32>(x) - static_cast<f32>(settlement.grid_x), 2.0f) +
-                std::pow(static_cast<f32>(y) - static_cast<f32>(settlement.grid_y), 2.0f)
-            );
-            if (dist < min_dist) {
-                min_dist = dist;
-            }
-        }
-        // Score based on distance - farther is better
-        return min_dist / static_cast<f32>(grid_width_ + grid_height_);
-    };
-    
-    // Required settlements:
+    // Required settlements, each on the best-scored (farthest from earlier
+    // settlements, with jitter) spaced site, or any site if none is spaced:
     // 1. One near coast or river
     // 2. One near mountain
     // 3. One in plains
     // 4. One near forest
     // 5. Capital (as central as possible to settlements)
-    
-    // Find settlement near coast or river
-    std::vector<std::pair<u16, u16>> candidates;
-    for (u16 y = 0; y < grid_height_; ++y) {
-        for (u16 x = 0; x < grid_width_; ++x) {
-            Region* region = GetRegionAtGrid(world, x, y);
-            if (!region || region->GetType() == "Coastal" || region->GetType() == "River" || 
-                region->GetType() == "Water" || region->GetType() == "Mountain") {
-                continue;
-            }
-            
-            bool near_water = false;
-            Region* neighbors[4] = {
-                GetRegionAtGrid(world, x, y - 1),
-                GetRegionAtGrid(world, x, y + 1),
-                GetRegionAtGrid(world, x - 1, y),
-                GetRegionAtGrid(world, x + 1, y)
-            };
-            
-            for (Region* neighbor : neighbors) {
-                if (neighbor && (neighbor->GetType() == "Coastal" || neighbor->GetType() == "River")) {
-                    near_water = true;
-                    break;
-                }
-            }
-            
-            if (near_water && CanPlaceRegion(world, x, y, urban_def)) {
-                candidates.push_back({x, y});
-            }
-        }
-    }
-    
-    if (!candidates.empty()) {
-        // Filter candidates to only those far enough from existing settlements
-        std::vector<std::pair<u16, u16>> valid_candidates;
-        for (const auto& candidate : candidates) {
-            if (IsFarEnoughFromSettlements(candidate.first, candidate.second)) {
-                valid_candidates.push_back(candidate);
-            }
-        }
-        
-        // If no valid candidates, try with reduced distance requirement
-        if (valid_candidates.empty()) {
-            valid_candidates = candidates;
-        }
-        
-        // Score candidates and pick from top candidates (prefer farther from existing)
-        std::vector<std::pair<std::pair<u16, u16>, f32>> scored_candidates;
-        for (const auto& candidate : valid_candidates) {
-            f32 score = ScoreCandidate(candidate.first, candidate.second);
-            scored_candidates.push_back({candidate, score});
-        }
-        
-        // Sort by score (highest first)
-        std::sort(scored_candidates.begin(), scored_candidates.end(),
-                  [](const auto& a, const auto& b) { return a.second > b.second; });
-        
-        // Pick from top 30% of candidates (or at least top 3, or all if less than 3)
-        u32 top_count = std::max(1u, std::min(static_cast<u32>(scored_candidates.size()), 
-                                               std::max(3u, static_cast<u32>(scored_candidates.size() * 0.3f))));
-        u32 selected_idx = random_->RandomU32(0, top_count);
-        auto pos = scored_candidates[selected_idx].first;
-        
-        Region* region = GetRegionAtGrid(world, pos.first, pos.second);
-        if (region) {
-            RegionID id = region->GetID();
-            f32 wx = region->GetX();
-            f32 wy = region->GetY();
-            auto& regions = world->GetRegions();
-            
-            regions[id] = std::make_unique<Region>(id, "Urban");
-            regions[id]->SetPosition(wx, wy);
-            regions[id]->SetIsSource(true);
-            regions[id]->SetName("Port City");
-            regions[id]->Initialize();
-            world->AddSourceRegion(id);
-            
-            World::Settlement settlement;
-            settlement.region_id = id;
-            settlement.type = "City";
-            settlement.grid_x = pos.first;
-            settlement.grid_y = pos.second;
-            settlements.push_back(settlement);
-        }
-    }
-    
-    // Find settlement near mountain
-    candidates.clear();
-    for (u16 y = 0; y < grid_height_; ++y) {
-        for (u16 x = 0; x < grid_width_; ++x) {
-            Region* region = GetRegionAtGrid(world, x, y);
-            if (!region || region->GetType() == "Mountain" || region->GetType() == "Water" || 
-                region->GetType() == "Coastal") {
-                continue;
-            }
-            
-            bool near_mountain = false;
-            Region* neighbors[4] = {
-                GetRegionAtGrid(world, x, y - 1),
-                GetRegionAtGrid(world, x, y + 1),
-                GetRegionAtGrid(world, x - 1, y),
-                GetRegionAtGrid(world, x + 1, y)
-            };
-            
-            for (Region* neighbor : neighbors) {
-                if (neighbor && neighbor->GetType() == "Mountain") {
-                    near_mountain = true;
-                    break;
-                }
-            }
-            
-            if (near_mountain && CanPlaceRegion(world, x, y, urban_def)) {
-                candidates.push_back({x, y});
-            }
-        }
-    }
-    
-    if (!candidates.empty()) {
-        // Filter candidates to only those far enough from existing settlements
-        std::vector<std::pair<u16, u16>> valid_candidates;
-        for (const auto& candidate : candidates) {
-            if (IsFarEnoughFromSettlements(candidate.first, candidate.second)) {
-                valid_candidates.push_back(candidate);
-            }
-        }
-        
-        // If no valid candidates, try with reduced distance requirement
-        if (valid_candidates.empty()) {
-            valid_candidates = candidates;
-        }
-        
-        // Score candidates and pick from top candidates
-        std::vector<std::pair<std::pair<u16, u16>, f32>> scored_candidates;
-        for (const auto& candidate : valid_candidates) {
-            f32 score = ScoreCandidate(candidate.first, candidate.second);
-            scored_candidates.push_back({candidate, score});
-        }
-        
-        std::sort(scored_candidates.begin(), scored_candidates.end(),
-                  [](const auto& a, const auto& b) { return a.second > b.second; });
-        
-        u32 top_count = std::max(1u, std::min(static_cast<u32>(scored_candidates.size()), 
-                                               std::max(3u, static_cast<u32>(scored_candidates.size() * 0.3f))));
-        u32 selected_idx = random_->RandomU32(0, top_count);
-        auto pos = scored_candidates[selected_idx].first;
-        
-        Region* region = GetRegionAtGrid(world, pos.first, pos.second);
-        if (region) {
-            RegionID id = region->GetID();
-            f32 wx = region->GetX();
-            f32 wy = region->GetY();
-            auto& regions = world->GetRegions();
-            
-            regions[id] = std::make_unique<Region>(id, "Urban");
-            regions[id]->SetPosition(wx, wy);
-            regions[id]->SetIsSource(true);
-            regions[id]->SetName("Mountain City");
-            regions[id]->Initialize();
-            world->AddSourceRegion(id);
-            
-            World::Settlement settlement;
-            settlement.region_id = id;
-            settlement.type = "City";
-            settlement.grid_x = pos.first;
-            settlement.grid_y = pos.second;
-            settlements.push_back(settlement);
-        }
-    }
-    
-    // Find settlement in plains
-    candidates.clear();
-    for (u16 y = 0; y < grid_height_; ++y) {
-        for (u16 x = 0; x < grid_width_; ++x) {
-            Region* region = GetRegionAtGrid(world, x, y);
-            if (region && region->GetType() == "Plains" && CanPlaceRegion(world, x, y, rural_def)) {
-                candidates.push_back({x, y});
-            }
-        }
-    }
-    
-    if (!candidates.empty()) {
-        // Filter candidates to only those far enough from existing settlements
-        std::vector<std::pair<u16, u16>> valid_candidates;
-        for (const auto& candidate : candidates) {
-            if (IsFarEnoughFromSettlements(candidate.first, candidate.second)) {
-                valid_candidates.push_back(candidate);
-            }
-        }
-        
-        // If no valid candidates, try with reduced distance requirement
-        if (valid_candidates.empty()) {
-            valid_candidates = candidates;
-        }
-        
-        // Score candidates and pick from top candidates
-        std::vector<std::pair<std::pair<u16, u16>, f32>> scored_candidates;
-        for (const auto& candidate : valid_candidates) {
-            f32 score = ScoreCandidate(candidate.first, candidate.second);
-            scored_candidates.push_back({candidate, score});
-        }
-        
-        std::sort(scored_candidates.begin(), scored_candidates.end(),
-                  [](const auto& a, const auto& b) { return a.second > b.second; });
-        
-        u32 top_count = std::max(1u, std::min(static_cast<u32>(scored_candidates.size()), 
-                                               std::max(3u, static_cast<u32>(scored_candidates.size() * 0.3f))));
-        u32 selected_idx = random_->RandomU32(0, top_count);
-        auto pos = scored_candidates[selected_idx].first;
-        
-        Region* region = GetRegionAtGrid(world, pos.first, pos.second);
-        if (region) {
-            RegionID id = region->GetID();
-            f32 wx = region->GetX();
-            f32 wy = region->GetY();
-            auto& regions = world->GetRegions();
-            
-            regions[id] = std::make_unique<Region>(id, "Rural");
-            regions[id]->SetPosition(wx, wy);
-            regions[id]->SetIsSource(true);
-            regions[id]->SetName("Plains Village");
-            regions[id]->Initialize();
-            world->AddSourceRegion(id);
-            
-            World::Settlement settlement;
-            settlement.region_id = id;
-            settlement.type = "Village";
-            settlement.grid_x = pos.first;
-            settlement.grid_y = pos.second;
-            settlements.push_back(settlement);
-        }
-    }
-    
-    // Find settlement near forest
-    candidates.clear();
-    for (u16 y = 0; y < grid_height_; ++y) {
-        for (u16 x = 0; x < grid_width_; ++x) {
-            Region* region = GetRegionAtGrid(world, x, y);
-            if (!region || region->GetType() == "Forest" || region->GetType() == "Water" || 
-                region->GetType() == "Coastal") {
-                continue;
-            }
-            
-            bool near_forest = false;
-            Region* neighbors[4] = {
-                GetRegionAtGrid(world, x, y - 1),
-                GetRegionAtGrid(world, x, y + 1),
-                GetRegionAtGrid(world, x - 1, y),
-                GetRegionAtGrid(world, x + 1, y)
-            };
-            
-            for (Region* neighbor : neighbors) {
-                if (neighbor && neighbor->GetType() == "Forest") {
-                    near_forest = true;
-                    break;
-                }
-            }
-            
-            if (near_forest && CanPlaceRegion(world, x, y, rural_def)) {
-                candidates.push_back({x, y});
-            }
+    auto PlaceRequired = [&](SettlementSite site, TypeID type, const std::string& name,
+                             const std::string& settlement_type) {
+        CurrentPass().attempts++;
+        GatherSettlementCandidates(site, type, true);
+        if (settlement_sampler_.GetCandidateCount() == 0) {
+            CurrentPass().rejections++;
+            return;
         }
-    }
-    
-    if (!candidates.empty()) {
-        // Filter candidates to only those far enough from existing settlements
-        std::vector<std::pair<u16, u16>> valid_candidates;
-        for (const auto& candidate : candidates) {
-            if (IsFarEnoughFromSettlements(candidate.first, candidate.second)) {
-                valid_candidates.push_back(candidate);
+        if (!PlaceSettlement(world, settlements, site, type, true, name, settlement_type)) {
+            GatherSettlementCandidates(site, type, true);
+            if (!PlaceSettlement(world, settlements, site, type, false, name, settlement_type)) {
+                CurrentPass().rejections++;
             }
         }
-        
-        // If no valid candidates, try with reduced distance requirement
-        if (valid_candidates.empty()) {
-            valid_candidates = candidates;
-        }
-        
-        // Score candidates and pick from top candidates
-        std::vector<std::pair<std::pair<u16, u16>, f32>> scored_candidates;
-        for (const auto& candidate : valid_candidates) {
-            f32 score = ScoreCandidate(candidate.first, candidate.second);
-            scored_candidates.push_back({candidate, score});
-        }
-        
-        std::sort(scored_candidates.begin(), scored_candidates.end(),
-                  [](const auto& a, const auto& b) { return a.second > b.second; });
-        
-        u32 top_count = std::max(1u, std::min(static_cast<u32>(scored_candidates.size()), 
-                                               std::max(3u, static_cast<u32>(scored_candidates.size() * 0.3f))));
-        u32 selected_idx = random_->RandomU32(0, top_count);
-        auto pos = scored_candidates[selected_idx].first;
-        
-        Region* region = GetRegionAtGrid(world, pos.first, pos.second);
-        if (region) {
-            RegionID id = region->GetID();
-            f32 wx = region->GetX();
-            f32 wy = region->GetY();
-            auto& regions = world->GetRegions();
-            
-            regions[id] = std::make_unique<Region>(id, "Rural");
-            regions[id]->SetPosition(wx, wy);
-            regions[id]->SetIsSource(true);
-            regions[id]->SetName("Forest Village");
-            regions[id]->Initialize();
-            world->AddSourceRegion(id);
-            
-            World::Settlement settlement;
-            settlement.region_id = id;
-            settlement.type = "Village";
-            settlement.grid_x = pos.first;
-            settlement.grid_y = pos.second;
-            settlements.push_back(settlement);
-        }
-    }
+    };
+    PlaceRequired(SITE_WATERSIDE, TYPE_URBAN, "Port City", "City");
+    PlaceRequired(SITE_MOUNTAINSIDE, TYPE_URBAN, "Mountain City", "City");
+    PlaceRequired(SITE_PLAINS, TYPE_RURAL, "Plains Village", "Village");
+    PlaceRequired(SITE_FORESTSIDE, TYPE_RURAL, "Forest Village", "Village");
     
     // Place capital as central as possible to settlements
     if (!settlements.empty()) {
+        CurrentPass().attempts++;
         std::vector<std::pair<u16, u16>> settlement_positions;
         for (const auto& settlement : settlements) {
             settlement_positions.push_back({settlement.grid_x, settlement.grid_y});
@@ -1431,278 +1183,429 @@ void StandardWorldGenerator::Pass_Settlements(
         
         auto centroid = CalculateCentroid(settlement_positions);
         
+        // Search square rings around the centroid for the nearest site, spaced
+        // if possible; once a spaced site is found, rings beyond its distance
+        // cannot hold a nearer one. Ties go to the first in row-major order.
         std::pair<u16, u16> best_pos = centroid;
-        f32 best_dist = std::numeric_limits<f32>::max();
-        
-        for (i16 dy = -10; dy <= 10; ++dy) {
-            for (i16 dx = -10; dx <= 10; ++dx) {
-                i16 nx = static_cast<i16>(centroid.first) + dx;
-                i16 ny = static_cast<i16>(centroid.second) + dy;
-                
-                if (nx >= 0 && nx < static_cast<i16>(grid_width_) &&
-                    ny >= 0 && ny < static_cast<i16>(grid_height_)) {
+        u64 best_spaced_key = std::numeric_limits<u64>::max();
+        u64 best_any_key = std::numeric_limits<u64>::max();
+        std::pair<u16, u16> best_spaced_pos = centroid;
+        std::pair<u16, u16> best_any_pos = centroid;
+        
+        for (i32 ring = 0; ring <= CAPITAL_SEARCH_RADIUS; ++ring) {
+            for (i32 dy = -ring; dy <= ring; ++dy) {
+                i32 step = (dy == -ring || dy == ring) ? 1 : std::max(2 * ring, 1);
+                for (i32 dx = -ring; dx <= ring; dx += step) {
+                    i32 nx = static_cast<i32>(centroid.first) + dx;
+                    i32 ny = static_cast<i32>(centroid.second) + dy;
+                    if (nx < 0 || nx >= static_cast<i32>(grid_width_) ||
+                        ny < 0 || ny >= static_cast<i32>(grid_height_)) {
+                        continue;
+                    }
                     u16 gx = static_cast<u16>(nx);
                     u16 gy = static_cast<u16>(ny);
                     
-                    // Prefer positions that are far enough from existing settlements
-                    if (!IsFarEnoughFromSettlements(gx, gy)) {
+                    TypeID cell_type = cells_.GetType(gx, gy);
+                    if (cell_type == TYPE_WATER || cell_type == TYPE_MOUNTAIN ||
+                        cell_type == TYPE_COASTAL || !CanPlaceRegion(gx, gy, TYPE_URBAN)) {
                         continue;
                     }
                     
-                    Region* region = GetRegionAtGrid(world, gx, gy);
-                    if (region && region->GetType() != "Water" && region->GetType() != "Mountain" && 
-                        region->GetType() != "Coastal" && CanPlaceRegion(world, gx, gy, urban_def)) {
-                        f32 dist = std::sqrt(
-                            std::pow(static_cast<f32>(nx) - static_cast<f32>(centroid.first), 2.0f) +
-                            std::pow(static_cast<f32>(ny) - static_cast<f32>(centroid.second), 2.0f)
-                        );
-                        if (dist < best_dist) {
-                            best_dist = dist;
-                            best_pos = {gx, gy};
-                        }
+                    // Squared distance, then row-major position
+                    u64 key = (static_cast<u64>(dx * dx + dy * dy) << 32) | cells_.GetCell(gx, gy);
+                    if (key < best_any_key) {
+                        best_any_key = key;
+                        best_any_pos = {gx, gy};
+                    }
+                    if (key < best_spaced_key && settlement_sampler_.IsFarEnough(gx, gy)) {
+                        best_spaced_key = key;
+                        best_spaced_pos = {gx, gy};
                     }
                 }
             }
+            if ((best_spaced_key >> 32) <= static_cast<u64>(ring * ring)) {
+                break;
+            }
         }
         
-        // If no position found with distance requirement, try without it
-        if (best_pos.first == centroid.first && best_pos.second == centroid.second) {
-            for (i16 dy = -10; dy <= 10; ++dy) {
-                for (i16 dx = -10; dx <= 10; ++dx) {
-                    i16 nx = static_cast<i16>(centroid.first) + dx;
-                    i16 ny = static_cast<i16>(centroid.second) + dy;
-                    
-                    if (nx >= 0 && nx < static_cast<i16>(grid_width_) &&
-                        ny >= 0 && ny < static_cast<i16>(grid_height_)) {
-                        Region* region = GetRegionAtGrid(world, static_cast<u16>(nx), static_cast<u16>(ny));
-                        if (region && region->GetType() != "Water" && region->GetType() != "Mountain" && 
-                            region->GetType() != "Coastal" && CanPlaceRegion(world, static_cast<u16>(nx), static_cast<u16>(ny), urban_def)) {
-                            f32 dist = std::sqrt(
-                                std::pow(static_cast<f32>(nx) - static_cast<f32>(centroid.first), 2.0f) +
-                                std::pow(static_cast<f32>(ny) - static_cast<f32>(centroid.second), 2.0f)
-                            );
-                            if (dist < best_dist) {
-                                best_dist = dist;
-                                best_pos = {static_cast<u16>(nx), static_cast<u16>(ny)};
-                            }
-                        }
-                    }
-                }
-            }
+        // If no position found with distance requirement, take the nearest without it
+        if (best_spaced_key != std::numeric_limits<u64>::max()) {
+            best_pos = best_spaced_pos;
+        } else if (best_any_key != std::numeric_limits<u64>::max()) {
+            best_pos = best_any_pos;
         }
         
-        Region* region = GetRegionAtGrid(world, best_pos.first, best_pos.second);
-        if (region) {
-            RegionID id = region->GetID();
-            f32 wx = region->GetX();
-            f32 wy = region->GetY();
-            auto& regions = world->GetRegions();
-            
-            regions[id] = std::make_unique<Region>(id, "Urban");
-            regions[id]->SetPosition(wx, wy);
-            regions[id]->SetIsSource(true);
-            regions[id]->SetName("Capital");
-            regions[id]->Initialize();
-            world->AddSourceRegion(id);
-            
-            World::Settlement settlement;
-            settlement.region_id = id;
-            settlement.type = "Capital";
-            settlement.grid_x = best_pos.first;
-            settlement.grid_y = best_pos.second;
-            settlements.push_back(settlement);
+        RegionID id = cells_.GetCell(best_pos.first, best_pos.second);
+        cells_.SetSource(id, TYPE_URBAN, "Capital");
+        world->AddSourceRegion(id);
+        
+        World::Settlement settlement;
+        settlement.region_id = id;
+        settlement.type = "Capital";
+        settlement.grid_x = best_pos.first;
+        settlement.grid_y = best_pos.second;
+        settlements.push_back(settlement);
+        settlement_sampler_.Insert(best_pos.first, best_pos.second);
+    }
+    
+    // Extra villages on plains: Poisson-disk dart throwing over the plains
+    // cells in random order, each checked against its nearby buckets only
+    u32 extra_settlements = Config::Configuration::GetInstance().world.extra_settlements;
+    if (extra_settlements > 0) {
+        GatherSettlementCandidates(SITE_PLAINS, TYPE_RURAL, false);
+        u32 placed = 0;
+        while (placed < extra_settlements &&
+               PlaceSettlement(world, settlements, SITE_PLAINS, TYPE_RURAL, true, "Village", "Village")) {
+            placed++;
         }
+        CurrentPass().attempts += extra_settlements;
+        CurrentPass().rejections += extra_settlements - placed;
+        LOG_DEBUG("Placed " << placed << "/" << extra_settlements << " extra villages");
     }
     
     // Expand Urban and Rural sources
-    const auto& all_source_regions = world->GetSourceRegions();
-    for (RegionID source_id : all_source_regions) {
-        Region* source_region = world->GetRegion(source_id);
-        if (source_region && (source_region->GetType() == "Urban" || source_region->GetType() == "Rural")) {
-            auto it = region_definitions.find(source_region->GetType());
-            if (it != region_definitions.end() && it->second.max_expansion_size > 0) {
-                Pass_ExpandFromSource(world, source_id, it->second);
-            }
+    std::vector<RegionID> urban_sources;
+    std::vector<RegionID> rural_sources;
+    for (RegionID source_id : world->GetSourceRegions()) {
+        TypeID source_type = cells_.GetTypeAt(source_id);
+        if (source_type == TYPE_URBAN) {
+            urban_sources.push_back(source_id);
+        } else if (source_type == TYPE_RURAL) {
+            rural_sources.push_back(source_id);
         }
     }
+    if (urban_def.max_expansion_size > 0) {
+        ExpandSources(urban_sources, urban_def);
+    }
+    if (rural_def.max_expansion_size > 0) {
+        ExpandSources(rural_sources, rural_def);
+    }
     
     // Add all settlements to world
     for (const auto& settlement : settlements) {
         world->AddSettlement(settlement);
     }
     
-    std::cout << "Placed " << settlements.size() << " settlements" << std::endl;
+    LOG_DEBUG("Placed " << settlements.size() << " settlements");
+}
+
+bool StandardWorldGenerator::IsSettlementSite(u16 x, u16 y, SettlementSite site, TypeID type) {
+    TypeID cell_type = cells_.GetType(x, y);
+    if (site == SITE_PLAINS) {
+        return cell_type == TYPE_PLAINS && CanPlaceRegion(x, y, type);
+    }
+    
+    // The other sites lie next to a feature, but not on it, on water or on the coast
+    TypeID feature = site == SITE_MOUNTAINSIDE ? TYPE_MOUNTAIN :
+                     site == SITE_FORESTSIDE ? TYPE_FOREST : TYPE_RIVER;
+    if (cell_type == feature || cell_type == TYPE_WATER || cell_type == TYPE_COASTAL ||
+        (site == SITE_WATERSIDE && cell_type == TYPE_MOUNTAIN)) {
+        return false;
+    }
+    
+    TypeID neighbors[4] = {
+        cells_.GetType(x, y - 1),
+        cells_.GetType(x, y + 1),
+        cells_.GetType(x - 1, y),
+        cells_.GetType(x + 1, y)
+    };
+    
+    bool near_feature = false;
+    for (TypeID neighbor : neighbors) {
+        if (neighbor == feature || (site == SITE_WATERSIDE && neighbor == TYPE_COASTAL)) {
+            near_feature = true;
+            break;
+        }
+    }
+    return near_feature && CanPlaceRegion(x, y, type);
+}
+
+void StandardWorldGenerator::GatherSettlementCandidates(SettlementSite site, TypeID type, bool score_by_distance) {
+    settlement_sampler_.ClearCandidates(score_by_distance);
+    f32 min_jitter = score_by_distance ? SETTLEMENT_SCORE_JITTER : 0.0f;
+    for (u16 y = 0; y < grid_height_; ++y) {
+        for (u16 x = 0; x < grid_width_; ++x) {
+            if (IsSettlementSite(x, y, site, type)) {
+                settlement_sampler_.AddCandidate(cells_.GetCell(x, y),
+                                                 random_.RandomFloat(min_jitter, 1.0f));
+            }
+        }
+    }
+}
+
+bool StandardWorldGenerator::PlaceSettlement(World* world, std::vector<World::Settlement>& settlements,
+                                             SettlementSite site, TypeID type, bool spaced,
+                                             const std::string& name, const std::string& settlement_type) {
+    // Earlier placements may have taken or blocked a candidate since it was gathered
+    u32 cell = settlement_sampler_.TakeBest([&](u32 candidate) {
+        return IsSettlementSite(cells_.GetCellX(candidate), cells_.GetCellY(candidate), site, type);
+    }, spaced);
+    if (cell == SettlementSampler::NO_CELL) {
+        return false;
+    }
+    
+    cells_.SetSource(cell, type, name);
+    world->AddSourceRegion(cell);
+    
+    World::Settlement settlement;
+    settlement.region_id = cell;
+    settlement.type = settlement_type;
+    settlement.grid_x = cells_.GetCellX(cell);
+    settlement.grid_y = cells_.GetCellY(cell);
+    settlements.push_back(settlement);
+    settlement_sampler_.Insert(settlement.grid_x, settlement.grid_y);
+    return true;
 }
 
 void StandardWorldGenerator::Pass_Roads(
     World* world,
     const std::unordered_map<std::string, RegionDefinition>& region_definitions) {
     
-    std::cout << "\n=== Pass: Roads ===" << std::endl;
+    LOG_DEBUG("=== Pass: Roads ===");
     
     auto road_it = region_definitions.find("Road");
     if (road_it == region_definitions.end()) {
-        std::cout << "Pass_Roads: Skipped - Road type not in region definitions" << std::endl;
+        LOG_INFO("Pass_Roads: Skipped - Road type not in region definitions");
         return;
     }
     
     const auto& settlements = world->GetSettlements();
     if (settlements.size() < 2) {
-        std::cout << "Pass_Roads: Skipped - Not enough settlements" << std::endl;
+        LOG_INFO("Pass_Roads: Skipped - Not enough settlements");
         return;
     }
     
-    // Path roads between all settlements
-    for (size_t i = 0; i < settlements.size(); ++i) {
-        for (size_t j = i + 1; j < settlements.size(); ++j) {
-            std::pair<u16, u16> start = {settlements[i].grid_x, settlements[i].grid_y};
-            std::pair<u16, u16> end = {settlements[j].grid_x, settlements[j].grid_y};
-            
-            std::vector<std::pair<u16, u16>> path = FindRoadPath(world, start, end);
-            
-            if (!path.empty()) {
-                World::Road road;
-                road.from_region = settlements[i].region_id;
-                road.to_region = settlements[j].region_id;
-                road.path = path;
-                world->AddRoad(road);
-                
-                // Place road regions along path
-                for (const auto& path_pos : path) {
-                    Region* region = GetRegionAtGrid(world, path_pos.first, path_pos.second);
-                    if (region && region->GetType() != "Water" && region->GetType() != "Mountain" && 
-                        region->GetType() != "Coastal") {
-                        // Check if this region has prevent_overwrite set
-                        auto& config = Config::Configuration::GetInstance();
-                        const auto& region_defs = config.regions.region_definitions;
-                        auto existing_region_it = region_defs.find(region->GetType());
-                        if (existing_region_it != region_defs.end() && existing_region_it->second.prevent_overwrite) {
-                            continue;  // Skip regions that prevent overwrite
-                        }
-                        
-                        if (region->GetType() == "Plains" || region->GetType() == "Forest" || 
-                            region->GetType() == "Desert" ||
-                            region->GetType() == "Road") {
-                            RegionID id = region->GetID();
-                            f32 rx_world = region->GetX();
-                            f32 ry_world = region->GetY();
-                            auto& regions = world->GetRegions();
-                            
-                            bool was_source = region->IsSource();
-                            std::string region_name = region->GetName();
-                            RegionID parent_id = region->GetSourceParentID();
-                            
-                            regions[id] = std::make_unique<Region>(id, "Road");
-                            regions[id]->SetPosition(rx_world, ry_world);
-                            if (was_source) {
-                                regions[id]->SetIsSource(true);
-                                regions[id]->SetName(region_name);
-                            } else if (parent_id != INVALID_REGION_ID) {
-                                regions[id]->SetSourceParentID(parent_id);
-                            }
-                            regions[id]->Initialize();
-                        }
-                    }
+    BuildRoadCosts();
+    
+    const auto& sites = settlements;
+    const size_t site_count = sites.size();
+    auto Distance = [&](size_t a, size_t b) -> f32 {
+        f32 dx = static_cast<f32>(sites[a].grid_x) - static_cast<f32>(sites[b].grid_x);
+        f32 dy = static_cast<f32>(sites[a].grid_y) - static_cast<f32>(sites[b].grid_y);
+        return std::sqrt(dx * dx + dy * dy);
+    };
+    
+    // Euclidean minimum spanning tree (Prim's, dense O(S^2)); it is the MST of
+    // the Delaunay graph as well. Each settlement joining the tree is routed to
+    // the cheapest cell of the network built so far, so roads merge.
+    std::vector<std::pair<u16, u16>> network;
+    std::vector<bool> in_network(static_cast<size_t>(grid_width_) * grid_height_, false);
+    auto AddToNetwork = [&](const std::pair<u16, u16>& cell) {
+        size_t index = static_cast<size_t>(cell.second) * grid_width_ + cell.first;
+        if (!in_network[index]) {
+            in_network[index] = true;
+            network.push_back(cell);
+        }
+    };
+    
+    std::vector<f32> best_distance(site_count, std::numeric_limits<f32>::max());
+    best_distance[0] = 0.0f;
+    std::vector<size_t> best_parent(site_count, 0);
+    std::vector<bool> in_tree(site_count, false);
+    std::vector<std::vector<size_t>> tree_neighbors(site_count);
+    std::vector<std::pair<u16, u16>> path;
+    
+    for (size_t step = 0; step < site_count; ++step) {
+        size_t next = 0;
+        f32 next_distance = std::numeric_limits<f32>::max();
+        for (size_t i = 0; i < site_count; ++i) {
+            if (!in_tree[i] && best_distance[i] < next_distance) {
+                next = i;
+                next_distance = best_distance[i];
+            }
+        }
+        in_tree[next] = true;
+        
+        std::pair<u16, u16> site_cell = {sites[next].grid_x, sites[next].grid_y};
+        if (step > 0) {
+            size_t parent = best_parent[next];
+            tree_neighbors[parent].push_back(next);
+            tree_neighbors[next].push_back(parent);
+            CurrentPass().attempts++;
+            if (road_pathfinder_.FindPath(network, site_cell, path) && !path.empty()) {
+                PlaceRoad(world, sites[parent].region_id, sites[next].region_id, path);
+                for (const auto& cell : path) {
+                    AddToNetwork(cell);
+                }
+            } else {
+                CurrentPass().rejections++;
+            }
+        }
+        AddToNetwork(site_cell);
+        
+        for (size_t i = 0; i < site_count; ++i) {
+            f32 distance = Distance(next, i);
+            if (!in_tree[i] && distance < best_distance[i]) {
+                best_distance[i] = distance;
+                best_parent[i] = next;
+            }
+        }
+    }
+    
+    // Redundancy: link near neighbours whose tree route is a long detour
+    struct ExtraLink {
+        size_t a;
+        size_t b;
+        f32 detour;
+    };
+    std::vector<ExtraLink> extras;
+    std::vector<f32> tree_distance(site_count);
+    std::vector<size_t> stack;
+    std::vector<size_t> nearest;
+    for (size_t a = 0; a < site_count; ++a) {
+        std::fill(tree_distance.begin(), tree_distance.end(), -1.0f);
+        tree_distance[a] = 0.0f;
+        stack.assign(1, a);
+        while (!stack.empty()) {
+            size_t current = stack.back();
+            stack.pop_back();
+            for (size_t neighbor : tree_neighbors[current]) {
+                if (tree_distance[neighbor] < 0.0f) {
+                    tree_distance[neighbor] = tree_distance[current] + Distance(current, neighbor);
+                    stack.push_back(neighbor);
                 }
             }
         }
+        
+        nearest.clear();
+        for (size_t b = 0; b < site_count; ++b) {
+            if (b != a) {
+                nearest.push_back(b);
+            }
+        }
+        size_t candidate_count = std::min<size_t>(ROAD_CANDIDATE_NEIGHBORS, nearest.size());
+        std::partial_sort(nearest.begin(), nearest.begin() + candidate_count, nearest.end(),
+                          [&](size_t x, size_t y) { return Distance(a, x) < Distance(a, y); });
+        for (size_t k = 0; k < candidate_count; ++k) {
+            size_t b = nearest[k];
+            f32 direct = Distance(a, b);
+            if (a < b && tree_distance[b] > ROAD_DETOUR_FACTOR * direct) {
+                extras.push_back({a, b, tree_distance[b] / std::max(direct, 1.0f)});
+            }
+        }
+    }
+    std::sort(extras.begin(), extras.end(), [](const ExtraLink& x, const ExtraLink& y) { return x.detour > y.detour; });
+    extras.resize(std::min(extras.size(), std::max<size_t>(1, site_count / ROAD_EXTRA_LINK_DIVISOR)));
+    for (const ExtraLink& link : extras) {
+        std::pair<u16, u16> start = {sites[link.a].grid_x, sites[link.a].grid_y};
+        std::pair<u16, u16> end = {sites[link.b].grid_x, sites[link.b].grid_y};
+        path = FindRoadPath(world, start, end);
+        CurrentPass().attempts++;
+        if (!path.empty()) {
+            PlaceRoad(world, sites[link.a].region_id, sites[link.b].region_id, path);
+        } else {
+            CurrentPass().rejections++;
+        }
     }
     
-    std::cout << "Created " << world->GetRoads().size() << " roads" << std::endl;
+    LOG_DEBUG("Created " << world->GetRoads().size() << " roads");
+}
+
+void StandardWorldGenerator::PlaceRoad(World* world, RegionID from_region, RegionID to_region,
+                                       const std::vector<std::pair<u16, u16>>& path) {
+    World::Road road;
+    road.from_region = from_region;
+    road.to_region = to_region;
+    road.path = path;
+    world->AddRoad(road);
+    
+    // Place road regions along path
+    for (const auto& path_pos : path) {
+        TypeID type = cells_.GetType(path_pos.first, path_pos.second);
+        // Merged roads share cells that are already converted
+        if (type != TYPE_PLAINS && type != TYPE_FOREST && type != TYPE_DESERT) {
+            continue;
+        }
+        // Check if this region has prevent_overwrite set
+        if (type_rules_[type].prevent_overwrite) {
+            continue;  // Skip regions that prevent overwrite
+        }
+        
+        // Sources keep their flag and name; other cells keep their parent
+        u32 cell = cells_.GetCell(path_pos.first, path_pos.second);
+        if (cells_.IsSource(cell)) {
+            cells_.SetType(cell, TYPE_ROAD);
+            cells_.SetSourceParent(cell, INVALID_REGION_ID);
+        } else {
+            cells_.SetCell(cell, TYPE_ROAD, cells_.GetSourceParent(cell));
+        }
+        road_pathfinder_.SetClass(path_pos.first, path_pos.second, TYPE_ROAD);
+    }
 }
 
 std::string StandardWorldGenerator::GetRandomName(const RegionDefinition& def) {
     if (def.potential_names.empty()) {
         return def.type;
     }
-    u32 idx = random_->RandomU32(0, static_cast<u32>(def.potential_names.size()));
+    u32 idx = random_.RandomU32(0, static_cast<u32>(def.potential_names.size()) - 1);
     return def.potential_names[idx];
 }
 
-bool StandardWorldGenerator::CanPlaceRegion(World* world, u16 x, u16 y, const RegionDefinition& def) {
-    Region* region = GetRegionAtGrid(world, x, y);
-    if (!region) {
+bool StandardWorldGenerator::CanPlaceRegion(u16 x, u16 y, TypeID type) {
+    if (x >= grid_width_ || y >= grid_height_ || type >= placement_masks_.size()) {
         return false;
     }
+    SyncPlacementMasks();
+    return placement_masks_[type].Test(cells_.GetCell(x, y));
+}
 
-    // Check if the existing region has prevent_overwrite set
-    auto& config = Config::Configuration::GetInstance();
-    const auto& region_definitions = config.regions.region_definitions;
-    auto existing_region_it = region_definitions.find(region->GetType());
-    if (existing_region_it != region_definitions.end() && existing_region_it->second.prevent_overwrite) {
-        return false;  // Cannot overwrite a region that has prevent_overwrite set
-    }
-
-    // Never allow any region to overwrite an existing Coastal region
-    if (region->GetType() == "Coastal") {
-        return false;
-    }
-    
-    // Prevent non-coastal regions from being placed on borders that have coastal regions
-    if (def.type != "Coastal" && IsOnRim(x, y)) {
-        bool on_top = (y == 0);
-        bool on_bottom = (y == grid_height_ - 1);
-        bool on_left = (x == 0);
-        bool on_right = (x == grid_width_ - 1);
+void StandardWorldGenerator::BuildPlacementMasks() {
+    std::vector<PlacementRule>& rules = placement_rules_;
+    rules.assign(cells_.GetTypeCount(), PlacementRule{});
+    for (size_t type = 0; type < rules.size(); ++type) {
+        PlacementRule& rule = rules[type];
+        const TypeRules& type_rule = type_rules_[type];
         
-        if ((on_top && coastal_borders_.find("top") != coastal_borders_.end()) ||
-            (on_bottom && coastal_borders_.find("bottom") != coastal_borders_.end()) ||
-            (on_left && coastal_borders_.find("left") != coastal_borders_.end()) ||
-            (on_right && coastal_borders_.find("right") != coastal_borders_.end())) {
-            return false;
+        // May replace Plains, its own type and compatible types, but never
+        // Coastal or a type that has prevent_overwrite set
+        rule.allowed_on[TYPE_PLAINS] = 1;
+        rule.allowed_on[type] = 1;
+        for (TypeID compatible : type_rule.compatible) {
+            rule.allowed_on[compatible] = 1;
         }
-    }
-    
-    // Check if current type is compatible
-    bool can_place_on = false;
-    if (region->GetType() == "Plains" || region->GetType() == def.type) {
-        can_place_on = true;
-    } else {
-        for (const auto& compatible_type : def.compatible_neighbors) {
-            if (region->GetType() == compatible_type) {
-                can_place_on = true;
-                break;
+        rule.allowed_on[TYPE_COASTAL] = 0;
+        for (size_t cell_type = 0; cell_type < rules.size(); ++cell_type) {
+            if (type_rules_[cell_type].prevent_overwrite) {
+                rule.allowed_on[cell_type] = 0;
             }
         }
+        for (TypeID incompatible : type_rule.incompatible) {
+            rule.incompatible[incompatible] = 1;
+        }
+        
+        // Non-coastal regions stay off borders that have coastal regions
+        if (type != TYPE_COASTAL) {
+            if (coastal_borders_.count("top")) rule.blocked_rims |= PlacementRule::RIM_TOP;
+            if (coastal_borders_.count("bottom")) rule.blocked_rims |= PlacementRule::RIM_BOTTOM;
+            if (coastal_borders_.count("left")) rule.blocked_rims |= PlacementRule::RIM_LEFT;
+            if (coastal_borders_.count("right")) rule.blocked_rims |= PlacementRule::RIM_RIGHT;
+        }
     }
     
-    if (!can_place_on) {
-        return false;
+    PlacementMask::BuildAll(cells_, placement_rules_, placement_masks_);
+    cells_.ClearChanges();
+}
+
+void StandardWorldGenerator::SyncPlacementMasks() {
+    const std::vector<u32>& changes = cells_.GetChanges();
+    if (changes.empty()) {
+        return;
     }
-    
-    // Check neighbors for incompatibility
-    for (i16 dy = -1; dy <= 1; ++dy) {
-        for (i16 dx = -1; dx <= 1; ++dx) {
-            if (dx == 0 && dy == 0) continue;
-            
-            i16 nx = static_cast<i16>(x) + dx;
-            i16 ny = static_cast<i16>(y) + dy;
-            
-            if (nx < 0 || nx >= static_cast<i16>(grid_width_) ||
-                ny < 0 || ny >= static_cast<i16>(grid_height_)) {
-                continue;
-            }
-            
-            Region* neighbor = GetRegionAtGrid(world, static_cast<u16>(nx), static_cast<u16>(ny));
-            if (neighbor) {
-                std::string neighbor_type = neighbor->GetType();
-                for (const auto& incompatible : def.incompatible_neighbors) {
-                    if (neighbor_type == incompatible) {
-                        return false;
-                    }
-                }
+    // A local update re-evaluates 9 cells per type; past this many changes a
+    // full sweep is cheaper
+    if (changes.size() > cells_.GetCellCount() / 256) {
+        PlacementMask::BuildAll(cells_, placement_rules_, placement_masks_);
+    } else {
+        for (u32 cell : changes) {
+            for (PlacementMask& mask : placement_masks_) {
+                mask.Update(cells_, cell);
             }
         }
     }
-    
-    return true;
+    cells_.ClearChanges();
 }
 
 // Helper methods
-Region* StandardWorldGenerator::GetRegionAtGrid(World* world, u16 gx, u16 gy) {
-    return world->GetRegionAtGrid(gx, gy);
-}
-
 bool StandardWorldGenerator::IsOnRim(u16 x, u16 y) const {
     return (x == 0 || x == grid_width_ - 1 || y == 0 || y == grid_height_ - 1);
 }
@@ -1711,107 +1614,7 @@ bool StandardWorldGenerator::IsInNorthernHemisphere(u16 y) const {
     return y < grid_height_ / 2;
 }
 
-std::vector<std::pair<u16, u16>> StandardWorldGenerator::FindPath(World* /*world*/, 
-                                                                    const std::pair<u16, u16>& start,
-                                                                    const std::pair<u16, u16>& end) {
-    std::vector<std::pair<u16, u16>> path;
-    
-    i16 start_x = static_cast<i16>(start.first);
-    i16 start_y = static_cast<i16>(start.second);
-    i16 end_x = static_cast<i16>(end.first);
-    i16 end_y = static_cast<i16>(end.second);
-    
-    i16 current_x = start_x;
-    i16 current_y = start_y;
-    std::unordered_set<u32> visited_positions;
-    u32 max_path_length = static_cast<u32>(grid_width_ + grid_height_) * 2;
-    u32 step_count = 0;
-    
-    while (step_count < max_path_length) {
-        step_count++;
-        i16 dx = end_x - current_x;
-        i16 dy = end_y - current_y;
-        
-        // Check if we've reached the destination
-        if (current_x == end_x && current_y == end_y) {
-            // Add destination to path if not already there
-            if (path.empty() || path.back().first != end.first || path.back().second != end.second) {
-                path.push_back({static_cast<u16>(end_x), static_cast<u16>(end_y)});
-            }
-            break;
-        }
-        
-        if (std::abs(dx) <= 1 && std::abs(dy) <= 1) {
-            // We're adjacent to destination, move to it and add it
-            current_x = end_x;
-            current_y = end_y;
-            u16 rx = static_cast<u16>(current_x);
-            u16 ry = static_cast<u16>(current_y);
-            if (rx != start.first || ry != start.second) {
-                path.push_back({rx, ry});
-            }
-            break;
-        }
-        
-        i16 move_x = 0;
-        i16 move_y = 0;
-        
-        if (std::abs(dx) > std::abs(dy)) {
-            move_x = (dx > 0) ? 1 : -1;
-        } else {
-            move_y = (dy > 0) ? 1 : -1;
-        }
-        
-        if (random_->RandomFloat(0.0f, 1.0f) < 0.15f) {
-            if (move_x != 0) {
-                move_y = random_->RandomBool(0.5f) ? 1 : -1;
-            } else {
-                move_x = random_->RandomBool(0.5f) ? 1 : -1;
-            }
-        }
-        
-        current_x += move_x;
-        current_y += move_y;
-        
-        if (current_x < 0) current_x = 0;
-        if (current_x >= static_cast<i16>(grid_width_)) current_x = static_cast<i16>(grid_width_) - 1;
-        if (current_y < 0) current_y = 0;
-        if (current_y >= static_cast<i16>(grid_height_)) current_y = static_cast<i16>(grid_height_) - 1;
-        
-        u16 rx = static_cast<u16>(current_x);
-        u16 ry = static_cast<u16>(current_y);
-        
-        u32 pos_key = static_cast<u32>(ry) * static_cast<u32>(grid_width_) + static_cast<u32>(rx);
-        if (visited_positions.find(pos_key) != visited_positions.end()) {
-            break;
-        }
-        
-        visited_positions.insert(pos_key);
-        
-        if (rx != start.first || ry != start.second) {
-            path.push_back({rx, ry});
-        }
-    }
-    
-    // Ensure the destination is included in the path if we're close but didn't reach it
-    if (!path.empty()) {
-        auto& last_pos = path.back();
-        i16 dx = end_x - static_cast<i16>(last_pos.first);
-        i16 dy = end_y - static_cast<i16>(last_pos.second);
-        if (std::abs(dx) <= 1 && std::abs(dy) <= 1 && (dx != 0 || dy != 0)) {
-            // Add the destination if we're adjacent but didn't reach it
-            path.push_back({static_cast<u16>(end_x), static_cast<u16>(end_y)});
-        }
-    } else if (start.first != end.first || start.second != end.second) {
-        // If path is empty and start != end, add destination
-        path.push_back({static_cast<u16>(end_x), static_cast<u16>(end_y)});
-    }
-    
-    return path;
-}
-
-std::vector<std::pair<u16, u16>> StandardWorldGenerator::FindPathWithMerging(World* world,
-                                                                              const std::pair<u16, u16>& start,
+std::vector<std::pair<u16, u16>> StandardWorldGenerator::FindPathWithMerging(const std::pair<u16, u16>& start,
                                                                               const std::pair<u16, u16>& end) {
     std::vector<std::pair<u16, u16>> path;
     
@@ -1873,8 +1676,7 @@ std::vector<std::pair<u16, u16>> StandardWorldGenerator::FindPathWithMerging(Wor
                     continue;
                 }
                 
-                Region* check_region = GetRegionAtGrid(world, static_cast<u16>(check_x), static_cast<u16>(check_y));
-                if (check_region && check_region->GetType() == "River") {
+                if (cells_.GetType(static_cast<u16>(check_x), static_cast<u16>(check_y)) == TYPE_RIVER) {
                     u32 check_pos_key = static_cast<u32>(check_y) * static_cast<u32>(grid_width_) + static_cast<u32>(check_x);
                     if (visited_positions.find(check_pos_key) != visited_positions.end()) {
                         continue;
@@ -1909,7 +1711,7 @@ std::vector<std::pair<u16, u16>> StandardWorldGenerator::FindPathWithMerging(Wor
                 merge_dy = (merge_dy > 0) ? 1 : -1;
             }
             
-            if (random_->RandomFloat(0.0f, 1.0f) < 0.40f) {
+            if (random_.RandomFloat(0.0f, 1.0f) < 0.40f) {
                 final_move_x = merge_dx;
                 final_move_y = merge_dy;
             } else {
@@ -1921,11 +1723,11 @@ std::vector<std::pair<u16, u16>> StandardWorldGenerator::FindPathWithMerging(Wor
                 }
             }
         } else {
-            if (random_->RandomFloat(0.0f, 1.0f) < 0.15f) {
+            if (random_.RandomFloat(0.0f, 1.0f) < 0.15f) {
                 if (move_x != 0) {
-                    final_move_y = random_->RandomBool(0.5f) ? 1 : -1;
+                    final_move_y = random_.RandomBool(0.5f) ? 1 : -1;
                 } else {
-                    final_move_x = random_->RandomBool(0.5f) ? 1 : -1;
+                    final_move_x = random_.RandomBool(0.5f) ? 1 : -1;
                 }
             }
         }
@@ -1970,42 +1772,37 @@ std::vector<std::pair<u16, u16>> StandardWorldGenerator::FindPathWithMerging(Wor
     return path;
 }
 
-std::pair<u16, u16> StandardWorldGenerator::FindNearestWaterSource(World* world, u16 x, u16 y) {
-    std::pair<u16, u16> nearest = {0xFFFF, 0xFFFF};
-    f32 min_dist = std::numeric_limits<f32>::max();
-    
-    for (u16 cy = 0; cy < grid_height_; ++cy) {
-        for (u16 cx = 0; cx < grid_width_; ++cx) {
-            Region* region = GetRegionAtGrid(world, cx, cy);
-            if (region && (region->GetType() == "Coastal" || region->GetType() == "River" || 
-                           region->GetType() == "Water")) {
-                f32 dist = std::sqrt(
-                    std::pow(static_cast<f32>(x) - static_cast<f32>(cx), 2.0f) +
-                    std::pow(static_cast<f32>(y) - static_cast<f32>(cy), 2.0f)
-                );
-                if (dist < min_dist) {
-                    min_dist = dist;
-                    nearest = {cx, cy};
-                }
+void StandardWorldGenerator::BuildFeatureIndex(FeatureIndex& index, std::initializer_list<TypeID> types) {
+    u32 cell_count = cells_.GetCellCount();
+    feature_sites_.assign(cell_count, 0);
+    for (u32 cell = 0; cell < cell_count; ++cell) {
+        TypeID cell_type = cells_.GetTypeAt(cell);
+        for (TypeID type : types) {
+            if (cell_type == type) {
+                feature_sites_[cell] = 1;
+                break;
             }
         }
     }
-    
-    return nearest;
+    index.Build(grid_width_, grid_height_, feature_sites_);
 }
 
-std::pair<u16, u16> StandardWorldGenerator::FindNearestNonCoastalBorder(World* world) {
-    for (u16 y = 0; y < grid_height_; ++y) {
-        for (u16 x = 0; x < grid_width_; ++x) {
-            if (IsOnRim(x, y)) {
-                Region* region = GetRegionAtGrid(world, x, y);
-                if (region && region->GetType() != "Coastal") {
-                    return {x, y};
-                }
-            }
-        }
+std::pair<u16, u16> StandardWorldGenerator::FindNearestBorder(u16 x, u16 y) const {
+    // Closest point of each border is straight across; ties prefer top, bottom, left, right
+    std::pair<u16, u16> nearest = {x, 0};
+    u16 min_dist = y;
+    if (static_cast<u16>(grid_height_ - 1 - y) < min_dist) {
+        min_dist = static_cast<u16>(grid_height_ - 1 - y);
+        nearest = {x, static_cast<u16>(grid_height_ - 1)};
+    }
+    if (x < min_dist) {
+        min_dist = x;
+        nearest = {0, y};
     }
-    return {0xFFFF, 0xFFFF};
+    if (static_cast<u16>(grid_width_ - 1 - x) < min_dist) {
+        nearest = {static_cast<u16>(grid_width_ - 1), y};
+    }
+    return nearest;
 }
 
 std::pair<u16, u16> StandardWorldGenerator::CalculateCentroid(const std::vector<std::pair<u16, u16>>& positions) {
@@ -2026,23 +1823,21 @@ std::pair<u16, u16> StandardWorldGenerator::CalculateCentroid(const std::vector<
     return {centroid_x, centroid_y};
 }
 
-std::vector<std::pair<u16, u16>> StandardWorldGenerator::FindRoadPath(World* world,
+std::vector<std::pair<u16, u16>> StandardWorldGenerator::FindRoadPath(World* /*world*/,
                                                                        const std::pair<u16, u16>& start,
                                                                        const std::pair<u16, u16>& end) {
-    struct Node {
-        u16 x, y;
-        u32 g_cost;
-        u32 h_cost;
-        u32 f_cost() const { return g_cost + h_cost; }
-        std::pair<u16, u16> parent;
-        
-        bool operator<(const Node& other) const {
-            return f_cost() > other.f_cost();
-        }
-    };
-    
-    auto GetTerrainCost = [](const std::string& region_type) -> u32 {
-        if (region_type == "Plains" || region_type == "Urban" || region_type == "Rural" || region_type == "Road") {
+    // Costs come from BuildRoadCosts, run at the start of Pass_Roads
+    std::vector<std::pair<u16, u16>> path;
+    road_pathfinder_.FindPath(start, end, path);
+    return path;
+}
+
+void StandardWorldGenerator::BuildRoadCosts() {
+    // Cell types are the terrain classes; regions without a type cannot be crossed
+    auto GetTerrainCost = [](const std::string& region_type) -> u16 {
+        if (region_type.empty()) {
+            return GridPathfinder::BLOCKED;
+        } else if (region_type == "Plains" || region_type == "Urban" || region_type == "Rural" || region_type == "Road") {
             return 1;
         } else if (region_type == "Forest" || region_type == "Mountain") {
             return 10;
@@ -2053,107 +1848,16 @@ std::vector<std::pair<u16, u16>> StandardWorldGenerator::FindRoadPath(World* wor
         }
     };
     
-    auto Heuristic = [](u16 x1, u16 y1, u16 x2, u16 y2) -> u32 {
-        return static_cast<u32>(std::abs(static_cast<i32>(x1) - static_cast<i32>(x2)) + 
-                                std::abs(static_cast<i32>(y1) - static_cast<i32>(y2)));
-    };
-    
-    std::priority_queue<Node> open_set;
-    std::unordered_map<u32, Node> all_nodes;
-    std::unordered_set<u32> closed_set;
-    
-    Node start_node;
-    start_node.x = start.first;
-    start_node.y = start.second;
-    start_node.g_cost = 0;
-    start_node.h_cost = Heuristic(start.first, start.second, end.first, end.second);
-    start_node.parent = {0xFFFF, 0xFFFF};
-    
-    u32 start_key = static_cast<u32>(start.second) * static_cast<u32>(grid_width_) + static_cast<u32>(start.first);
-    all_nodes[start_key] = start_node;
-    open_set.push(start_node);
-    
-    const i16 dx[] = {0, 1, 0, -1};
-    const i16 dy[] = {-1, 0, 1, 0};
+    for (size_t type = 0; type < cells_.GetTypeCount(); ++type) {
+        road_pathfinder_.SetClassCost(static_cast<u8>(type), GetTerrainCost(cells_.GetTypeName(static_cast<TypeID>(type))));
+    }
     
-    while (!open_set.empty()) {
-        Node current = open_set.top();
-        open_set.pop();
-        
-        u32 current_key = static_cast<u32>(current.y) * static_cast<u32>(grid_width_) + static_cast<u32>(current.x);
-        
-        if (closed_set.find(current_key) != closed_set.end()) {
-            continue;
-        }
-        
-        closed_set.insert(current_key);
-        
-        if (current.x == end.first && current.y == end.second) {
-            std::vector<std::pair<u16, u16>> path;
-            Node* node = &all_nodes[current_key];
-            while (node->parent.first != 0xFFFF) {
-                path.push_back({node->x, node->y});
-                u32 parent_key = static_cast<u32>(node->parent.second) * static_cast<u32>(grid_width_) + 
-                                static_cast<u32>(node->parent.first);
-                auto it = all_nodes.find(parent_key);
-                if (it == all_nodes.end()) break;
-                node = &it->second;
-            }
-            std::reverse(path.begin(), path.end());
-            return path;
-        }
-        
-        for (int i = 0; i < 4; ++i) {
-            i16 nx = static_cast<i16>(current.x) + dx[i];
-            i16 ny = static_cast<i16>(current.y) + dy[i];
-            
-            if (nx < 0 || nx >= static_cast<i16>(grid_width_) ||
-                ny < 0 || ny >= static_cast<i16>(grid_height_)) {
-                continue;
-            }
-            
-            u16 gx = static_cast<u16>(nx);
-            u16 gy = static_cast<u16>(ny);
-            u32 neighbor_key = static_cast<u32>(gy) * static_cast<u32>(grid_width_) + static_cast<u32>(gx);
-            
-            if (closed_set.find(neighbor_key) != closed_set.end()) {
-                continue;
-            }
-            
-            Region* region = GetRegionAtGrid(world, gx, gy);
-            if (!region) {
-                continue;
-            }
-            
-            std::string region_type = region->GetType();
-            if (region_type.empty()) {
-                continue;
-            }
-            
-            u32 terrain_cost = GetTerrainCost(region_type);
-            u32 new_g_cost = current.g_cost + terrain_cost;
-            
-            auto it = all_nodes.find(neighbor_key);
-            if (it != all_nodes.end()) {
-                if (new_g_cost < it->second.g_cost) {
-                    it->second.g_cost = new_g_cost;
-                    it->second.parent = {current.x, current.y};
-                    open_set.push(it->second);
-                }
-            } else {
-                Node neighbor;
-                neighbor.x = gx;
-                neighbor.y = gy;
-                neighbor.g_cost = new_g_cost;
-                neighbor.h_cost = Heuristic(gx, gy, end.first, end.second);
-                neighbor.parent = {current.x, current.y};
-                all_nodes[neighbor_key] = neighbor;
-                open_set.push(neighbor);
-            }
+    road_pathfinder_.Resize(grid_width_, grid_height_);
+    for (u16 y = 0; y < grid_height_; ++y) {
+        for (u16 x = 0; x < grid_width_; ++x) {
+            road_pathfinder_.SetClass(x, y, cells_.GetType(x, y));
         }
     }
-    
-    return std::vector<std::pair<u16, u16>>();
 }
 
 } // namespace Simulation
\ No newline at end of file
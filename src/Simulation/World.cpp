@@ -1,4 +1,5 @@
 #include "Simulation/World.h"
+#include "Core/Config.h"
 #include <algorithm>
 
 namespace Simulation {
@@ -16,13 +17,18 @@ void World::Initialize(u16 grid_width, u16 grid_height, f32 region_size) {
     regions_.clear();
     settlements_.clear();
     roads_.clear();
+    adjacency_offsets_.clear();
+    adjacency_counts_.clear();
+    adjacency_targets_.clear();
     
-    // Calculate total regions
-    u32 total_regions = static_cast<u32>(grid_width) * static_cast<u32>(grid_height);
-    regions_.reserve(total_regions);
+    // Regions are reserved by whoever fills them (chunked worlds keep none here)
 }
 
 Region* World::GetRegion(RegionID region_id) {
+    // Generated worlds store region i at index i
+    if (region_id < regions_.size() && regions_[region_id] && regions_[region_id]->GetID() == region_id) {
+        return regions_[region_id].get();
+    }
     for (auto& region : regions_) {
         if (region && region->GetID() == region_id) {
             return region.get();
@@ -32,6 +38,9 @@ Region* World::GetRegion(RegionID region_id) {
 }
 
 const Region* World::GetRegion(RegionID region_id) const {
+    if (region_id < regions_.size() && regions_[region_id] && regions_[region_id]->GetID() == region_id) {
+        return regions_[region_id].get();
+    }
     for (const auto& region : regions_) {
         if (region && region->GetID() == region_id) {
             return region.get();
@@ -62,6 +71,156 @@ const Region* World::GetRegionAtGrid(u16 grid_x, u16 grid_y) const {
     return nullptr;
 }
 
+void World::RegenerateResources(f32 delta_time) {
+    auto& config = Config::Configuration::GetInstance();
+    f32 amount_per_capacity = config.simulation.region.resource_regeneration_rate * delta_time;
+    
+    for (auto& region : regions_) {
+        if (region) {
+            region->RegenerateResources(amount_per_capacity);
+        }
+    }
+}
+
+void World::BuildAdjacency() {
+    u32 total_regions = static_cast<u32>(regions_.size());
+    u32 row_capacity = 8u + adjacency_row_slack_;
+    
+    adjacency_offsets_.assign(total_regions + 1, 0);
+    adjacency_counts_.assign(total_regions, 0);
+    adjacency_targets_.assign(static_cast<size_t>(total_regions) * row_capacity, INVALID_REGION_ID);
+    
+    for (u32 i = 0; i < total_regions; ++i) {
+        adjacency_offsets_[i] = i * row_capacity;
+        
+        u16 x = static_cast<u16>(i % grid_width_);
+        u16 y = static_cast<u16>(i / grid_width_);
+        u8 count = 0;
+        for (i32 dy = -1; dy <= 1; ++dy) {
+            for (i32 dx = -1; dx <= 1; ++dx) {
+                if (dx == 0 && dy == 0) continue;
+                
+                i32 nx = static_cast<i32>(x) + dx;
+                i32 ny = static_cast<i32>(y) + dy;
+                if (nx < 0 || nx >= static_cast<i32>(grid_width_) ||
+                    ny < 0 || ny >= static_cast<i32>(grid_height_)) {
+                    continue;
+                }
+                
+                u32 neighbor = static_cast<u32>(ny) * static_cast<u32>(grid_width_) + static_cast<u32>(nx);
+                if (neighbor < total_regions) {
+                    adjacency_targets_[adjacency_offsets_[i] + count++] = neighbor;
+                }
+            }
+        }
+        adjacency_counts_[i] = count;
+    }
+    adjacency_offsets_[total_regions] = total_regions * row_capacity;
+}
+
+std::span<const RegionID> World::GetNeighbors(RegionID region_id) const {
+    if (region_id >= adjacency_counts_.size()) {
+        return {};
+    }
+    return {adjacency_targets_.data() + adjacency_offsets_[region_id], adjacency_counts_[region_id]};
+}
+
+void World::AddAdjacency(RegionID a, RegionID b) {
+    if (a >= adjacency_counts_.size() || b >= adjacency_counts_.size() || a == b) {
+        return;
+    }
+    
+    for (RegionID from : {a, b}) {
+        RegionID to = (from == a) ? b : a;
+        auto existing = GetNeighbors(from);
+        if (std::find(existing.begin(), existing.end(), to) != existing.end()) {
+            continue;
+        }
+        
+        if (adjacency_offsets_[from] + adjacency_counts_[from] >= adjacency_offsets_[from + 1]) {
+            GrowAdjacencyRows();
+        }
+        adjacency_targets_[adjacency_offsets_[from] + adjacency_counts_[from]++] = to;
+    }
+}
+
+void World::RemoveAdjacency(RegionID a, RegionID b) {
+    if (a >= adjacency_counts_.size() || b >= adjacency_counts_.size()) {
+        return;
+    }
+    
+    for (RegionID from : {a, b}) {
+        RegionID to = (from == a) ? b : a;
+        RegionID* row = adjacency_targets_.data() + adjacency_offsets_[from];
+        u8& count = adjacency_counts_[from];
+        for (u8 i = 0; i < count; ++i) {
+            if (row[i] == to) {
+                // Order within a row is not significant; swap with the last entry
+                row[i] = row[count - 1];
+                row[count - 1] = INVALID_REGION_ID;
+                --count;
+                break;
+            }
+        }
+    }
+}
+
+void World::GrowAdjacencyRows() {
+    // Rows are full; re-lay out the CSR arrays with twice the slack per row
+    u32 total_regions = static_cast<u32>(adjacency_counts_.size());
+    adjacency_row_slack_ = static_cast<u8>(std::min(adjacency_row_slack_ * 2, 255 - 8));
+    u32 row_capacity = 8u + adjacency_row_slack_;
+    
+    std::vector<RegionID> targets(static_cast<size_t>(total_regions) * row_capacity, INVALID_REGION_ID);
+    for (u32 i = 0; i < total_regions; ++i) {
+        std::copy_n(adjacency_targets_.begin() + adjacency_offsets_[i], adjacency_counts_[i],
+                    targets.begin() + static_cast<size_t>(i) * row_capacity);
+        adjacency_offsets_[i] = i * row_capacity;
+    }
+    adjacency_offsets_[total_regions] = total_regions * row_capacity;
+    adjacency_targets_ = std::move(targets);
+}
+
+void World::GetRegionsInRange(RegionID center, u8 range, std::vector<RegionID>& out) const {
+    out.clear();
+    if (center >= adjacency_counts_.size() || range == 0) {
+        return;
+    }
+    
+    // Per-thread visited stamps keep concurrent queries independent; the
+    // generation counter avoids clearing the array per query
+    thread_local std::vector<u32> visit_stamps;
+    thread_local u32 visit_generation = 0;
+    if (visit_stamps.size() < adjacency_counts_.size()) {
+        visit_stamps.resize(adjacency_counts_.size(), 0);
+    }
+    if (++visit_generation == 0) {
+        std::fill(visit_stamps.begin(), visit_stamps.end(), 0);
+        visit_generation = 1;
+    }
+    visit_stamps[center] = visit_generation;
+    
+    // 'out' doubles as the BFS queue; each ring is [ring_begin, ring_end)
+    size_t ring_begin = 0;
+    for (RegionID neighbor : GetNeighbors(center)) {
+        visit_stamps[neighbor] = visit_generation;
+        out.push_back(neighbor);
+    }
+    
+    for (u8 depth = 1; depth < range; ++depth) {
+        size_t ring_end = out.size();
+        for (size_t i = ring_begin; i < ring_end; ++i) {
+            for (RegionID neighbor : GetNeighbors(out[i])) {
+                if (visit_stamps[neighbor] != visit_generation) {
+                    visit_stamps[neighbor] = visit_generation;
+                    out.push_back(neighbor);
+                }
+            }
+        }
+        ring_begin = ring_end;
+    }
+}
+
 void World::AddSettlement(const Settlement& settlement) {
     settlements_.push_back(settlement);
 }
@@ -0,0 +1,403 @@
+#include "Simulation/WorldCache.h"
+#include "Utils/Logger.h"
+#include "Utils/MappedFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Simulation {
+
+namespace {
+constexpr u32 CACHE_MAGIC = 0x43575346;  // "FSWC"
+constexpr u32 CACHE_FORMAT_VERSION = 3;
+constexpr const char* SEED_FILE_NAME = "seed.txt";
+
+// Sequential writer that tracks its offset so arrays can be aligned
+class CacheWriter {
+public:
+    explicit CacheWriter(std::ofstream& out) : out_(out) {}
+
+    template <typename T>
+    void Write(const T& value) { WriteBytes(&value, sizeof(T)); }
+
+    void WriteBytes(const void* data, size_t size) {
+        out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        offset_ += size;
+    }
+
+    void WriteString(const std::string& value) {
+        Write(static_cast<u32>(value.size()));
+        WriteBytes(value.data(), value.size());
+    }
+
+    void Align(size_t alignment) {
+        static const char padding[8] = {};
+        WriteBytes(padding, (alignment - offset_ % alignment) % alignment);
+    }
+
+private:
+    std::ofstream& out_;
+    size_t offset_ = 0;
+};
+
+// Bounds-checked reader over mapped memory; fails sticky on overrun
+class CacheReader {
+public:
+    explicit CacheReader(std::span<const u8> data) : data_(data) {}
+
+    bool IsValid() const { return valid_; }
+    bool IsAtEnd() const { return offset_ == data_.size(); }
+
+    template <typename T>
+    T Read() {
+        T value{};
+        if (const u8* bytes = Take(sizeof(T))) {
+            std::memcpy(&value, bytes, sizeof(T));
+        }
+        return value;
+    }
+
+    std::string ReadString() {
+        u32 size = Read<u32>();
+        const u8* bytes = Take(size);
+        return bytes ? std::string(reinterpret_cast<const char*>(bytes), size) : std::string();
+    }
+
+    // Array of count elements in place (the file aligns arrays to their type)
+    template <typename T>
+    std::span<const T> ReadArray(size_t count) {
+        Align(alignof(T));
+        const u8* bytes = count <= data_.size() / sizeof(T) ? Take(count * sizeof(T)) : nullptr;
+        return bytes ? std::span<const T>(reinterpret_cast<const T*>(bytes), count) : std::span<const T>();
+    }
+
+    void Align(size_t alignment) {
+        Take((alignment - offset_ % alignment) % alignment);
+    }
+
+private:
+    std::span<const u8> data_;
+    size_t offset_ = 0;
+    bool valid_ = true;
+
+    const u8* Take(size_t size) {
+        if (!valid_ || size > data_.size() - offset_) {
+            valid_ = false;
+            return nullptr;
+        }
+        const u8* bytes = data_.data() + offset_;
+        offset_ += size;
+        return bytes;
+    }
+};
+}
+
+WorldCache::WorldCache(std::string directory)
+    : directory_(std::move(directory)) {
+}
+
+std::string WorldCache::GetPath(const Key& key) const {
+    char name[112];
+    std::snprintf(name, sizeof(name), "world_%ux%u_%016llx_%016llx_v%u.bin",
+                  static_cast<unsigned>(key.grid_width), static_cast<unsigned>(key.grid_height),
+                  static_cast<unsigned long long>(key.seed),
+                  static_cast<unsigned long long>(key.content_hash),
+                  static_cast<unsigned>(key.generator_version));
+    return (std::filesystem::path(directory_) / name).string();
+}
+
+bool WorldCache::Save(const Key& key, const CellGrid& cells, const World& world,
+                      std::span<const u8> generator_state) const {
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    if (error) {
+        LOG_ERROR("WorldCache: ERROR - Cannot create cache directory " << directory_
+               << ": " << error.message());
+        return false;
+    }
+
+    std::vector<u32> source_cells;
+    for (u32 cell = 0; cell < cells.GetCellCount(); ++cell) {
+        if (cells.IsSource(cell)) {
+            source_cells.push_back(cell);
+        }
+    }
+
+    // Write next to the final file and rename, so readers never see a partial cache
+    std::string path = GetPath(key);
+    std::string temp_path = path + ".tmp";
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    CacheWriter writer(out);
+
+    writer.Write(CACHE_MAGIC);
+    writer.Write(CACHE_FORMAT_VERSION);
+    writer.Write(key.grid_width);
+    writer.Write(key.grid_height);
+    writer.Write(key.generator_version);
+    writer.Write(key.seed);
+    writer.Write(key.content_hash);
+
+    writer.Write(static_cast<u32>(cells.GetTypeCount()));
+    for (size_t type = 0; type < cells.GetTypeCount(); ++type) {
+        writer.WriteString(cells.GetTypeName(static_cast<CellGrid::TypeID>(type)));
+    }
+    std::span<const CellGrid::TypeID> types = cells.GetTypes();
+    std::span<const RegionID> parents = cells.GetSourceParents();
+    writer.WriteBytes(types.data(), types.size_bytes());
+    writer.Align(alignof(RegionID));
+    writer.WriteBytes(parents.data(), parents.size_bytes());
+
+    writer.Write(static_cast<u32>(source_cells.size()));
+    for (u32 cell : source_cells) {
+        writer.Write(cell);
+        writer.WriteString(cells.GetName(cell));
+    }
+
+    const auto& source_regions = world.GetSourceRegions();
+    writer.Write(static_cast<u32>(source_regions.size()));
+    writer.Align(alignof(RegionID));
+    writer.WriteBytes(source_regions.data(), source_regions.size() * sizeof(RegionID));
+
+    writer.Write(static_cast<u32>(world.GetSettlements().size()));
+    for (const auto& settlement : world.GetSettlements()) {
+        writer.Write(settlement.region_id);
+        writer.Write(settlement.grid_x);
+        writer.Write(settlement.grid_y);
+        writer.WriteString(settlement.type);
+    }
+
+    writer.Write(static_cast<u32>(world.GetRoads().size()));
+    for (const auto& road : world.GetRoads()) {
+        writer.Write(road.from_region);
+        writer.Write(road.to_region);
+        writer.Write(static_cast<u32>(road.path.size()));
+        for (const auto& [x, y] : road.path) {
+            writer.Write(x);
+            writer.Write(y);
+        }
+    }
+
+    writer.Write(static_cast<u32>(generator_state.size()));
+    writer.WriteBytes(generator_state.data(), generator_state.size());
+
+    out.close();
+    if (out) {
+        std::filesystem::rename(temp_path, path, error);
+    }
+    if (!out || error) {
+        LOG_ERROR("WorldCache: ERROR - Failed to write " << path);
+        std::filesystem::remove(temp_path, error);
+        return false;
+    }
+    return true;
+}
+
+bool WorldCache::Load(const Key& key, CellGrid& cells, World& world, std::vector<u8>& generator_state) const {
+    Utils::MappedFile file;
+    if (!file.Open(GetPath(key))) {
+        return false;
+    }
+    CacheReader reader(file.GetData());
+
+    if (reader.Read<u32>() != CACHE_MAGIC || reader.Read<u32>() != CACHE_FORMAT_VERSION ||
+        reader.Read<u16>() != key.grid_width || reader.Read<u16>() != key.grid_height ||
+        reader.Read<u32>() != key.generator_version || reader.Read<u64>() != key.seed ||
+        reader.Read<u64>() != key.content_hash || !reader.IsValid()) {
+        return false;
+    }
+
+    // Parse and validate everything before touching cells or world
+    u32 type_count = reader.Read<u32>();
+    if (type_count > CellGrid::INVALID_TYPE) {
+        return false;
+    }
+    std::vector<std::string> type_names(type_count);
+    for (std::string& name : type_names) {
+        name = reader.ReadString();
+    }
+
+    size_t cell_count = static_cast<size_t>(key.grid_width) * key.grid_height;
+    std::span<const CellGrid::TypeID> types = reader.ReadArray<CellGrid::TypeID>(cell_count);
+    std::span<const RegionID> parents = reader.ReadArray<RegionID>(cell_count);
+
+    u32 source_cell_count = reader.Read<u32>();
+    std::vector<std::pair<u32, std::string>> source_cells;
+    for (u32 i = 0; i < source_cell_count && reader.IsValid(); ++i) {
+        u32 cell = reader.Read<u32>();
+        std::string name = reader.ReadString();
+        if (cell >= cell_count) {
+            return false;
+        }
+        source_cells.emplace_back(cell, std::move(name));
+    }
+
+    u32 source_region_count = reader.Read<u32>();
+    std::span<const RegionID> source_regions = reader.ReadArray<RegionID>(source_region_count);
+
+    u32 settlement_count = reader.Read<u32>();
+    std::vector<World::Settlement> settlements;
+    for (u32 i = 0; i < settlement_count && reader.IsValid(); ++i) {
+        World::Settlement settlement;
+        settlement.region_id = reader.Read<RegionID>();
+        settlement.grid_x = reader.Read<u16>();
+        settlement.grid_y = reader.Read<u16>();
+        settlement.type = reader.ReadString();
+        settlements.push_back(std::move(settlement));
+    }
+
+    u32 road_count = reader.Read<u32>();
+    std::vector<World::Road> roads;
+    for (u32 i = 0; i < road_count && reader.IsValid(); ++i) {
+        World::Road road;
+        road.from_region = reader.Read<RegionID>();
+        road.to_region = reader.Read<RegionID>();
+        u32 path_length = reader.Read<u32>();
+        for (u32 step = 0; step < path_length && reader.IsValid(); ++step) {
+            u16 x = reader.Read<u16>();
+            u16 y = reader.Read<u16>();
+            road.path.emplace_back(x, y);
+        }
+        roads.push_back(std::move(road));
+    }
+
+    u32 state_size = reader.Read<u32>();
+    std::span<const u8> state = reader.ReadArray<u8>(state_size);
+
+    if (!reader.IsValid() || !reader.IsAtEnd()) {
+        return false;
+    }
+    for (CellGrid::TypeID type : types) {
+        if (type >= type_count) {
+            return false;
+        }
+    }
+
+    cells.ClearTypes();
+    for (const std::string& name : type_names) {
+        cells.InternType(name);
+    }
+    if (cells.GetTypeCount() != type_count) {
+        return false;  // Duplicate names; cells is regenerated by the caller anyway
+    }
+    cells.Assign(key.grid_width, key.grid_height, types, parents);
+    for (const auto& [cell, name] : source_cells) {
+        cells.SetSource(cell, cells.GetTypeAt(cell), name);
+        cells.SetSourceParent(cell, parents[cell]);
+    }
+
+    for (RegionID region_id : source_regions) {
+        world.AddSourceRegion(region_id);
+    }
+    for (const auto& settlement : settlements) {
+        world.AddSettlement(settlement);
+    }
+    for (const auto& road : roads) {
+        world.AddRoad(road);
+    }
+    generator_state.assign(state.begin(), state.end());
+
+    // Mark the file used, for Trim
+    std::error_code error;
+    std::filesystem::last_write_time(GetPath(key), std::filesystem::file_time_type::clock::now(), error);
+    return true;
+}
+
+void WorldCache::RemoveSuperseded(const Key& key, std::span<const u64> content_hashes) const {
+    // File names start with the grid size and seed (see GetPath)
+    char prefix_buffer[64];
+    std::snprintf(prefix_buffer, sizeof(prefix_buffer), "world_%ux%u_%016llx_",
+                  static_cast<unsigned>(key.grid_width), static_cast<unsigned>(key.grid_height),
+                  static_cast<unsigned long long>(key.seed));
+    std::string prefix = prefix_buffer;
+
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_, error)) {
+        std::string name = entry.path().filename().string();
+        if (name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        // Only names this cache writes, so other files are never touched
+        unsigned long long content_hash = 0;
+        unsigned version = 0;
+        if (std::sscanf(name.c_str() + prefix.size(), "%16llx_v%u", &content_hash, &version) != 2) {
+            continue;
+        }
+        Key file_key = key;
+        file_key.content_hash = content_hash;
+        file_key.generator_version = version;
+        if (std::filesystem::path(GetPath(file_key)).filename() != entry.path().filename()) {
+            continue;
+        }
+        if (version == key.generator_version &&
+            std::find(content_hashes.begin(), content_hashes.end(), content_hash) != content_hashes.end()) {
+            continue;
+        }
+        std::error_code remove_error;
+        std::filesystem::remove(entry.path(), remove_error);
+    }
+}
+
+void WorldCache::Trim(u64 max_bytes) const {
+    struct CacheFile {
+        std::filesystem::path path;
+        std::filesystem::file_time_type used;
+        u64 size;
+    };
+    std::vector<CacheFile> files;
+    u64 total = 0;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_, error)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("world_", 0) != 0 || entry.path().extension() != ".bin") {
+            continue;
+        }
+        std::error_code entry_error;
+        u64 size = entry.file_size(entry_error);
+        auto used = entry.last_write_time(entry_error);
+        if (!entry_error) {
+            files.push_back({entry.path(), used, size});
+            total += size;
+        }
+    }
+    if (total <= max_bytes) {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(), [](const CacheFile& a, const CacheFile& b) { return a.used < b.used; });
+    for (size_t i = 0; i + 1 < files.size() && total > max_bytes; ++i) {
+        std::error_code remove_error;
+        if (std::filesystem::remove(files[i].path, remove_error)) {
+            total -= files[i].size;
+        }
+    }
+}
+
+u64 WorldCache::LoadSeed() const {
+    std::ifstream in(std::filesystem::path(directory_) / SEED_FILE_NAME);
+    u64 seed = 0;
+    if (!(in >> seed)) {
+        return 0;
+    }
+    return seed;
+}
+
+bool WorldCache::SaveSeed(u64 seed) const {
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    std::filesystem::path path = std::filesystem::path(directory_) / SEED_FILE_NAME;
+    std::ofstream out(path, std::ios::trunc);
+    out << seed << '\n';
+    out.close();
+    if (error || !out) {
+        LOG_ERROR("WorldCache: ERROR - Failed to write " << path.string());
+        return false;
+    }
+    return true;
+}
+
+} // namespace Simulation
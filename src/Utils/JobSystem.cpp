@@ -0,0 +1,109 @@
+#include "Utils/JobSystem.h"
+
+namespace Utils {
+
+namespace {
+thread_local bool in_job = false;
+}
+
+JobSystem& JobSystem::GetInstance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+void JobSystem::Initialize(u32 thread_count) {
+    Shutdown();
+
+    if (thread_count == 0) {
+        u32 hardware_threads = std::thread::hardware_concurrency();
+        thread_count = hardware_threads > 1 ? hardware_threads - 1 : 0;
+    }
+
+    stopping_ = false;
+    workers_.reserve(thread_count);
+    for (u32 i = 0; i < thread_count; ++i) {
+        workers_.emplace_back(&JobSystem::WorkerLoop, this);
+    }
+}
+
+void JobSystem::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+void JobSystem::ParallelFor(u32 count, const std::function<void(u32)>& fn) {
+    if (count == 0) {
+        return;
+    }
+    if (workers_.empty() || count == 1 || in_job) {
+        for (u32 i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> caller_lock(caller_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        job_count_ = count;
+        next_index_.store(0, std::memory_order_relaxed);
+        busy_workers_ = static_cast<u32>(workers_.size());
+        ++job_generation_;
+    }
+    work_available_.notify_all();
+
+    RunJobIndices(fn, count);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, [this] { return busy_workers_ == 0; });
+    job_ = nullptr;
+}
+
+void JobSystem::WorkerLoop() {
+    u64 seen_generation = 0;
+    for (;;) {
+        const std::function<void(u32)>* job = nullptr;
+        u32 count = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_available_.wait(lock, [&] { return stopping_ || job_generation_ != seen_generation; });
+            if (stopping_) {
+                return;
+            }
+            seen_generation = job_generation_;
+            job = job_;
+            count = job_count_;
+        }
+
+        RunJobIndices(*job, count);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --busy_workers_;
+        }
+        work_done_.notify_one();
+    }
+}
+
+void JobSystem::RunJobIndices(const std::function<void(u32)>& fn, u32 count) {
+    in_job = true;
+    for (u32 i = next_index_.fetch_add(1, std::memory_order_relaxed); i < count;
+         i = next_index_.fetch_add(1, std::memory_order_relaxed)) {
+        fn(i);
+    }
+    in_job = false;
+}
+
+} // namespace Utils
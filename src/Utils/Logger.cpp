@@ -0,0 +1,39 @@
+#include "Utils/Logger.h"
+#include <cstdio>
+
+namespace Utils {
+
+Logger& Logger::GetInstance() {
+    static Logger instance;
+    return instance;
+}
+
+Logger::~Logger() {
+    Flush();
+}
+
+void Logger::Write(Level level, const std::string& message) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer_ += message;
+    buffer_ += '\n';
+    // Problems show up right away; everything else waits for a full buffer
+    if (level >= Level::Warning || buffer_.size() >= BUFFER_LIMIT) {
+        FlushLocked();
+    }
+}
+
+void Logger::Flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FlushLocked();
+}
+
+void Logger::FlushLocked() {
+    if (buffer_.empty()) {
+        return;
+    }
+    std::fwrite(buffer_.data(), 1, buffer_.size(), stdout);
+    std::fflush(stdout);
+    buffer_.clear();
+}
+
+} // namespace Utils
@@ -67,6 +67,17 @@ bool Random::RandomBool(f32 probability) {
     return RandomFloat() < probability;
 }
 
+u32 Random::RandomBinomial(u32 trials, f32 probability) {
+    if (trials == 0 || probability <= 0.0f) {
+        return 0;
+    }
+    if (probability >= 1.0f) {
+        return trials;
+    }
+    std::binomial_distribution<u32> dist(trials, probability);
+    return dist(generator_);
+}
+
 template<typename Container>
 auto Random::RandomChoice(const Container& container) -> decltype(*container.begin()) {
     if (container.empty()) {
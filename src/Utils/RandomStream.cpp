@@ -0,0 +1,37 @@
+#include "Utils/RandomStream.h"
+
+namespace Utils {
+
+RandomStream::RandomStream(u64 seed, u64 stream, u64 index)
+    : key_(DeriveKey(seed, stream, index)) {
+}
+
+u64 RandomStream::DeriveKey(u64 seed, u64 stream, u64 index) {
+    u64 key = Mix(seed + GAMMA);
+    key = Mix(key ^ (stream + GAMMA * 2));
+    return Mix(key ^ (index + GAMMA * 3));
+}
+
+u32 RandomStream::RandomU32(u32 min, u32 max) {
+    if (max <= min) {
+        return min;
+    }
+    // Multiply-shift with rejection of the biased low band (Lemire)
+    u64 range = static_cast<u64>(max - min) + 1;
+    if (range > 0xFFFFFFFFull) {
+        return RandomU32();
+    }
+    u32 span = static_cast<u32>(range);
+    u64 product = static_cast<u64>(RandomU32()) * span;
+    u32 low = static_cast<u32>(product);
+    if (low < span) {
+        u32 threshold = static_cast<u32>(-span) % span;
+        while (low < threshold) {
+            product = static_cast<u64>(RandomU32()) * span;
+            low = static_cast<u32>(product);
+        }
+    }
+    return min + static_cast<u32>(product >> 32);
+}
+
+} // namespace Utils